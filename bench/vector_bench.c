@@ -0,0 +1,402 @@
+///////////////////////////////////////////////////////////////////////////////
+// vector_bench.c
+// Benchmarks for the vector operations in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <time.h>
+#include "vector.h"
+#define MAX_LIST 16         // most sizes or counts on the command line
+#define MAX_EDIT 10000      // inserts or deletes timed per run
+#define MAX_MOVE 1000000000 // slots shifted by the timed edits of one run
+#define MIN_WORK 1000000    // elements handled per measurement at least
+#define RANGE 16            // elements removed by each vec_delrange
+
+// One measurement, summed over every run. 
+typedef struct bench_res_t {
+    double ns;              // time spent in the timed calls
+    size_t ops;             // number of operations timed
+    size_t allocs;          // allocations made by the timed calls
+} bench_res_t;
+
+// A benchmarked operation. 
+typedef struct bench_t {
+    const char *name;       // name of the operation
+    void (*run)(size_t, size_t, bench_res_t *);     // runs it once
+} bench_t;
+
+static void *bench_alloc(void *ctx, size_t n);
+static void *bench_resize(void *ctx, void *p, size_t n);
+static void bench_release(void *ctx, void *p);
+static double bench_now(void);
+static void bench_key(void);
+static int bench_cmp(const void *a, const void *b);
+static void bench_fill(vec_t *v, size_t size, size_t n);
+static void bench_add(size_t size, size_t n, bench_res_t *r);
+static void bench_ins_head(size_t size, size_t n, bench_res_t *r);
+static void bench_ins_mid(size_t size, size_t n, bench_res_t *r);
+static void bench_ins(size_t size, size_t n, bench_res_t *r, _Bool head);
+static void bench_del(size_t size, size_t n, bench_res_t *r);
+static void bench_delrange(size_t size, size_t n, bench_res_t *r);
+static void bench_sort(size_t size, size_t n, bench_res_t *r);
+static void bench_reverse(size_t size, size_t n, bench_res_t *r);
+static void bench_clear(size_t size, size_t n, bench_res_t *r);
+static size_t bench_edits(size_t n);
+static size_t bench_list(const char *s, size_t *out, size_t max);
+
+static size_t counted;              // allocations and resizes so far
+static uint64_t seed = 88172645463325252u;  // xorshift state
+static unsigned char elem[4096];    // the element being added
+static size_t keylen;               // bytes of the element that are random
+
+// Allocator counting every allocation and resize. 
+static const vec_alloc_t counter = {
+    bench_alloc, bench_resize, bench_release, NULL
+};
+
+// Every benchmarked operation. 
+static const bench_t benches[] = {
+    { "vec_add", bench_add },
+    { "vec_ins/head", bench_ins_head },
+    { "vec_ins/mid", bench_ins_mid },
+    { "vec_del", bench_del },
+    { "vec_delrange", bench_delrange },
+    { "vec_sort", bench_sort },
+    { "vec_reverse", bench_reverse },
+    { "vec_clear", bench_clear },
+};
+
+int main(int argc, char **argv) {
+    size_t counts[MAX_LIST] = { 1000, 10000, 100000, 1000000, 10000000 };
+    size_t sizes[MAX_LIST] = { 8, 64, 256 };
+    size_t ncounts = 5, nsizes = 3;
+
+    for (int i = 1; i < argc; i++) {
+        size_t *list = NULL, *len = NULL, max = 0;
+        if (strcmp(argv[i], "-n") == 0) {
+            list = counts;
+            len = &ncounts;
+            max = SIZE_MAX / 2;
+        } else if (strcmp(argv[i], "-s") == 0) {
+            list = sizes;
+            len = &nsizes;
+            max = sizeof(elem);
+        }
+        if (list == NULL || i + 1 == argc 
+                || (*len = bench_list(argv[++i], list, max)) == 0) {
+            fprintf(stderr, "usage: %s [-n count,...] [-s size,...]\n"
+                    "sizes are in bytes, at most %zu\n", argv[0], 
+                    sizeof(elem));
+            return 1;
+        }
+    }
+
+    printf("%-14s %6s %10s %12s %10s\n", "op", "size", "count", "ns/op", 
+            "allocs/op");
+    for (size_t s = 0; s < nsizes; s++) {
+        for (size_t c = 0; c < ncounts; c++) {
+            size_t runs = (counts[c] < MIN_WORK) ? MIN_WORK / counts[c] : 1;
+            for (size_t b = 0; b < sizeof(benches) / sizeof(*benches); b++) {
+                bench_res_t r = { 0, 0, 0 };
+                for (size_t k = 0; k < runs; k++)
+                    benches[b].run(sizes[s], counts[c], &r);
+                printf("%-14s %6zu %10zu %12.2f %10.3f\n", benches[b].name, 
+                        sizes[s], counts[c], r.ns / (double)r.ops, 
+                        (double)r.allocs / (double)r.ops);
+            }
+        }
+    }
+    return 0;
+}
+
+// Allocates n bytes using malloc, counting the call. 
+//
+// PARAMS: 
+// ctx - unused
+// n   - the number of bytes
+static void *bench_alloc(void *ctx, size_t n) {
+    (void)ctx;
+    counted++;
+    return malloc(n);
+}
+
+// Resizes the memory using realloc, counting the call. 
+//
+// PARAMS: 
+// ctx - unused
+// p   - the memory to resize
+// n   - the new number of bytes
+static void *bench_resize(void *ctx, void *p, size_t n) {
+    (void)ctx;
+    counted++;
+    return realloc(p, n);
+}
+
+// Frees the memory using free. 
+//
+// PARAMS: 
+// ctx - unused
+// p   - the memory to free
+static void bench_release(void *ctx, void *p) {
+    (void)ctx;
+    free(p);
+}
+
+// Reads the monotonic clock. 
+//
+// RET: 
+// The current time in nanoseconds. 
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Gives the element being added a new random key. 
+static void bench_key(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    memcpy(elem, &seed, keylen);
+}
+
+// Compares two elements by their random key. 
+//
+// PARAMS: 
+// a - pointer to the first element pointer
+// b - pointer to the second element pointer
+//
+// RET: 
+// Negative, zero or positive as a is before, equal to or after b. 
+static int bench_cmp(const void *a, const void *b) {
+    return memcmp(*(void *const *)a, *(void *const *)b, keylen);
+}
+
+// Initialises the vector on the counting allocator and adds n elements of 
+// the given size, untimed. 
+//
+// PARAMS: 
+// v    - the vector to fill
+// size - the size of each element
+// n    - the number of elements
+static void bench_fill(vec_t *v, size_t size, size_t n) {
+    keylen = (size < sizeof(seed)) ? size : sizeof(seed);
+    vec_init_alloc(v, &counter);
+    vec_reserve(v, n);
+    for (size_t i = 0; i < n; i++) {
+        bench_key();
+        vec_add(v, elem, size);
+    }
+}
+
+// Times n calls to vec_add on an empty vector. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_add(size_t size, size_t n, bench_res_t *r) {
+    vec_t v;
+    bench_fill(&v, size, 0);
+
+    size_t before = counted;
+    double t = bench_now();
+    for (size_t i = 0; i < n; i++) {
+        bench_key();
+        vec_add(&v, elem, size);
+    }
+    r->ns += bench_now() - t;
+    r->ops += n;
+    r->allocs += counted - before;
+    vec_free(&v);
+}
+
+// Times inserts at the head of a vector of n elements. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_ins_head(size_t size, size_t n, bench_res_t *r) {
+    bench_ins(size, n, r, true);
+}
+
+// Times inserts in the middle of a vector of n elements. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_ins_mid(size_t size, size_t n, bench_res_t *r) {
+    bench_ins(size, n, r, false);
+}
+
+// Times bench_edits(n) calls to vec_ins on a vector of n elements. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+// head - whether to insert at the head rather than the middle
+static void bench_ins(size_t size, size_t n, bench_res_t *r, _Bool head) {
+    vec_t v;
+    bench_fill(&v, size, n);
+    size_t k = bench_edits(n);
+
+    size_t before = counted;
+    double t = bench_now();
+    for (size_t i = 0; i < k; i++)
+        vec_ins(&v, elem, size, head ? 0 : v.len / 2);
+    r->ns += bench_now() - t;
+    r->ops += k;
+    r->allocs += counted - before;
+    vec_free(&v);
+}
+
+// Times bench_edits(n) calls to vec_del in the middle of a vector of n 
+// elements, including freeing the deleted elements. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_del(size_t size, size_t n, bench_res_t *r) {
+    vec_t v;
+    bench_fill(&v, size, n);
+    size_t k = bench_edits(n);
+
+    size_t before = counted;
+    double t = bench_now();
+    for (size_t i = 0; i < k; i++)
+        bench_release(NULL, vec_del(&v, v.len / 2));
+    r->ns += bench_now() - t;
+    r->ops += k;
+    r->allocs += counted - before;
+    vec_free(&v);
+}
+
+// Times calls to vec_delrange removing RANGE elements at a time from the 
+// middle of a vector of n elements, until bench_edits(n) are gone. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_delrange(size_t size, size_t n, bench_res_t *r) {
+    vec_t v;
+    bench_fill(&v, size, n);
+    size_t k = bench_edits(n) / RANGE;
+    k = (k == 0) ? 1 : k;
+
+    size_t before = counted;
+    double t = bench_now();
+    for (size_t i = 0; i < k; i++)
+        vec_delrange(&v, v.len / 2, RANGE);
+    r->ns += bench_now() - t;
+    r->ops += k;
+    r->allocs += counted - before;
+    vec_free(&v);
+}
+
+// Times vec_sort on a vector of n elements in random order, per element. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_sort(size_t size, size_t n, bench_res_t *r) {
+    vec_t v;
+    bench_fill(&v, size, n);
+
+    size_t before = counted;
+    double t = bench_now();
+    vec_sort(&v, bench_cmp);
+    r->ns += bench_now() - t;
+    r->ops += n;
+    r->allocs += counted - before;
+    vec_free(&v);
+}
+
+// Times vec_reverse on a vector of n elements, per element. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_reverse(size_t size, size_t n, bench_res_t *r) {
+    vec_t v;
+    bench_fill(&v, size, n);
+
+    size_t before = counted;
+    double t = bench_now();
+    vec_reverse(&v);
+    r->ns += bench_now() - t;
+    r->ops += n;
+    r->allocs += counted - before;
+    vec_free(&v);
+}
+
+// Times vec_clear on a vector of n elements, per element. 
+//
+// PARAMS: 
+// size - the size of each element
+// n    - the number of elements
+// r    - the measurement to add to
+static void bench_clear(size_t size, size_t n, bench_res_t *r) {
+    vec_t v;
+    bench_fill(&v, size, n);
+
+    size_t before = counted;
+    double t = bench_now();
+    vec_clear(&v);
+    r->ns += bench_now() - t;
+    r->ops += n;
+    r->allocs += counted - before;
+    vec_free(&v);
+}
+
+// Calculates the number of timed inserts or deletes on a vector of n 
+// elements, at most MAX_EDIT, and few enough on large vectors that the 
+// shifts stay around MAX_MOVE slots. 
+//
+// PARAMS: 
+// n - the number of elements
+//
+// RET: 
+// The number of edits, at least one. 
+static size_t bench_edits(size_t n) {
+    size_t k = (n < MAX_EDIT) ? n : MAX_EDIT;
+    if (k > MAX_MOVE / n)
+        k = MAX_MOVE / n;
+    return (k == 0) ? 1 : k;
+}
+
+// Parses a comma separated list of positive numbers such as "1000,1e6". 
+//
+// PARAMS: 
+// s   - the list to parse
+// out - where to store at most MAX_LIST numbers
+// max - the largest number allowed
+//
+// RET: 
+// The number of numbers parsed, zero on error. 
+static size_t bench_list(const char *s, size_t *out, size_t max) {
+    size_t n = 0;
+    while (n < MAX_LIST) {
+        char *end;
+        double x = strtod(s, &end);
+        if (end == s || x < 1 || x > (double)max)
+            return 0;
+        out[n++] = (size_t)x;
+        if (*end == '\0')
+            return n;
+        if (*end != ',')
+            return 0;
+        s = end + 1;
+    }
+    return 0;
+}
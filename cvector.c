@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////
+// cvector.c
+// Concurrent append-only vector in C99 using GCC atomic builtins. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#include "cvector.h"
+#define BASE ((size_t)1 << CVEC_BASE_BITS)
+
+static void **cvec_seg(cvec_t *c, size_t k);
+static inline size_t cvec_locate(size_t i, size_t *off);
+static void *cvec_new_elem(const void *d, size_t n);
+
+// Initialises the specified concurrent vector. Not thread-safe. 
+//
+// PARAMS: 
+// c - the vector to initialise
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int cvec_init(cvec_t *c) {
+    if (c == NULL)
+        return VEC_NULL_ERR;
+
+    int ret = VEC_GOOD;
+    for (size_t k = 0; k < CVEC_SEGS; k++)
+        c->segs[k] = NULL;
+    c->len = 0;
+    c->segs[0] = calloc(BASE, sizeof(void *));
+    if (c->segs[0] == NULL)
+        ret = VEC_ALLOC_ERR;
+    return ret;
+}
+
+// Adds a new element into the specified concurrent vector. The new element 
+// will be copied. Safe to call from many threads at once. 
+//
+// PARAMS: 
+// c   - the vector to add the element
+// d   - the element to add
+// n   - the size of the element
+// idx - where to store the index of the element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int cvec_add(cvec_t *c, const void *d, size_t n, size_t *idx) {
+    if (c == NULL || c->segs[0] == NULL)
+        return VEC_NULL_ERR;
+
+    void *elem = cvec_new_elem(d, n);
+    if (elem == NULL)
+        return VEC_ALLOC_ERR;
+
+    size_t off, i = __atomic_fetch_add(&c->len, 1, __ATOMIC_RELAXED);
+    size_t k = cvec_locate(i, &off);
+    void **seg = (k < CVEC_SEGS) ? cvec_seg(c, k) : NULL;
+    if (seg == NULL) {
+        free(elem);     // the slot stays reserved but unpublished
+        return VEC_ALLOC_ERR;
+    }
+
+    __atomic_store_n(&seg[off], elem, __ATOMIC_RELEASE);
+    if (idx != NULL)
+        *idx = i;
+    return VEC_GOOD;
+}
+
+// Returns the element in the concurrent vector specified by the index. Safe 
+// to call while other threads are adding. 
+//
+// PARAMS: 
+// c - the vector to get the element
+// i - the index of the element
+//
+// RET: 
+// The element, or NULL if it is out of range or not yet published. 
+void *cvec_get(const cvec_t *c, size_t i) {
+    if (c == NULL || i >= cvec_len(c))
+        return NULL;
+
+    size_t off, k = cvec_locate(i, &off);
+    if (k >= CVEC_SEGS)
+        return NULL;
+
+    void **seg = __atomic_load_n(&c->segs[k], __ATOMIC_ACQUIRE);
+    return (seg == NULL) ? NULL : __atomic_load_n(&seg[off], __ATOMIC_ACQUIRE);
+}
+
+// Returns the number of slots reserved in the concurrent vector. Slots being 
+// added by other threads may not be published yet. 
+//
+// PARAMS: 
+// c - the vector to get the length
+//
+// RET: 
+// The number of reserved slots. 
+size_t cvec_len(const cvec_t *c) {
+    return (c == NULL) ? 0 : __atomic_load_n(&c->len, __ATOMIC_ACQUIRE);
+}
+
+// Frees the specified concurrent vector and all of its elements. Not 
+// thread-safe. 
+//
+// PARAMS: 
+// c - the vector to free
+void cvec_free(cvec_t *c) {
+    if (c == NULL)
+        return;
+
+    for (size_t k = 0; k < CVEC_SEGS; k++) {
+        if (c->segs[k] == NULL)
+            continue;
+        for (size_t j = 0; j < (BASE << k); j++)
+            free(c->segs[k][j]);
+        free(c->segs[k]);
+        c->segs[k] = NULL;
+    }
+    c->len = 0;
+}
+
+// Returns segment k of the concurrent vector, allocating it if no other 
+// thread has done so. Racing threads agree on one segment with a CAS. 
+//
+// PARAMS: 
+// c - the vector owning the segment
+// k - the index of the segment
+//
+// RET: 
+// The segment, or NULL on error. 
+static void **cvec_seg(cvec_t *c, size_t k) {
+    void **seg = __atomic_load_n(&c->segs[k], __ATOMIC_ACQUIRE);
+    if (seg != NULL)
+        return seg;
+
+    void **fresh = calloc(BASE << k, sizeof(void *));
+    if (fresh == NULL)
+        return NULL;
+    if (__atomic_compare_exchange_n(&c->segs[k], &seg, fresh, false, 
+            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        return fresh;
+
+    free(fresh);    // lost the race, seg now holds the winner
+    return seg;
+}
+
+// Maps an index to its segment and the offset inside that segment. 
+//
+// PARAMS: 
+// i   - the index
+// off - where to store the offset
+//
+// RET: 
+// The index of the segment. 
+static inline size_t cvec_locate(size_t i, size_t *off) {
+    unsigned long long x = (unsigned long long)i + BASE;
+    size_t h = (size_t)(63 - __builtin_clzll(x));
+    *off = (size_t)(x - (1ULL << h));
+    return h - CVEC_BASE_BITS;
+}
+
+// Returns a copy of the specified element. 
+//
+// PARAMS: 
+// d - the element to copy
+// n - the size of the element
+static void *cvec_new_elem(const void *d, size_t n) {
+    if (d == NULL || n == 0)
+        return NULL;
+
+    void *ret = malloc(n);
+    if (ret != NULL)
+        memcpy(ret, d, n);
+    return ret;
+}
+
@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////
+// cvector.h
+// Concurrent append-only vector in C99 using GCC atomic builtins. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CVECTOR_H
+#define CVECTOR_H
+#include "vector.h"
+
+#define CVEC_BASE_BITS 5    // the first segment holds 1 << CVEC_BASE_BITS
+#define CVEC_SEGS 48        // size of the segment directory
+
+// The concurrent vector. Segment k holds (1 << CVEC_BASE_BITS) << k slots and 
+// segments never move, so readers never see a reallocated buffer. 
+typedef struct cvector_t {
+    void **segs[CVEC_SEGS]; // segment directory
+    size_t len;             // number of reserved slots
+} cvec_t;
+
+// Initialises the specified concurrent vector. Not thread-safe. 
+//
+// PARAMS: 
+// c - the vector to initialise
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int cvec_init(cvec_t *c);
+
+// Adds a new element into the specified concurrent vector. The new element 
+// will be copied. Safe to call from many threads at once. 
+//
+// PARAMS: 
+// c   - the vector to add the element
+// d   - the element to add
+// n   - the size of the element
+// idx - where to store the index of the element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int cvec_add(cvec_t *c, const void *d, size_t n, size_t *idx);
+
+// Returns the element in the concurrent vector specified by the index. Safe 
+// to call while other threads are adding. 
+//
+// PARAMS: 
+// c - the vector to get the element
+// i - the index of the element
+//
+// RET: 
+// The element, or NULL if it is out of range or not yet published. 
+void *cvec_get(const cvec_t *c, size_t i);
+
+// Returns the number of slots reserved in the concurrent vector. Slots being 
+// added by other threads may not be published yet. 
+//
+// PARAMS: 
+// c - the vector to get the length
+//
+// RET: 
+// The number of reserved slots. 
+size_t cvec_len(const cvec_t *c);
+
+// Frees the specified concurrent vector and all of its elements. Not 
+// thread-safe. 
+//
+// PARAMS: 
+// c - the vector to free
+void cvec_free(cvec_t *c);
+
+#endif
+
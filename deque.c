@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////
+// deque.c
+// Double-ended queue implementation in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#include "deque.h"
+#define DEF_MAX 16
+
+static _Bool deq_fix(deq_t *q);
+static inline _Bool deq_check(const deq_t *q);
+static inline size_t deq_slot(const deq_t *q, size_t i);
+static void *deq_new_elem(const void *d, size_t n);
+
+// Initialises the specified deque. 
+//
+// PARAMS: 
+// q - the deque to initialise
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int deq_init(deq_t *q) {
+    if (q == NULL)
+        return VEC_NULL_ERR;
+
+    int ret = VEC_GOOD;
+    q->head = 0;
+    q->len = 0;
+    q->max = DEF_MAX;
+    q->data = malloc(DEF_MAX * sizeof(void *));
+    if (q->data == NULL)
+        ret = VEC_ALLOC_ERR;
+    return ret;
+}
+
+// Adds a new element to the front of the specified deque. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// q - the deque to add the element
+// d - the element to add
+// n - the size of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int deq_push_front(deq_t *q, const void *d, size_t n) {
+    if (!deq_check(q))
+        return VEC_NULL_ERR;
+    if (!deq_fix(q))
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_ALLOC_ERR;
+    void *elem = deq_new_elem(d, n);
+    if (elem != NULL) {
+        q->head = (q->head - 1) & (q->max - 1);
+        q->data[q->head] = elem;
+        q->len++;
+        ret = VEC_GOOD;
+    }
+    return ret;
+}
+
+// Adds a new element to the back of the specified deque. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// q - the deque to add the element
+// d - the element to add
+// n - the size of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int deq_push_back(deq_t *q, const void *d, size_t n) {
+    if (!deq_check(q))
+        return VEC_NULL_ERR;
+    if (!deq_fix(q))
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_ALLOC_ERR;
+    void *elem = deq_new_elem(d, n);
+    if (elem != NULL) {
+        q->data[deq_slot(q, q->len)] = elem;
+        q->len++;
+        ret = VEC_GOOD;
+    }
+    return ret;
+}
+
+// Removes the first element in the specified deque. 
+//
+// PARAMS: 
+// q - the deque to remove the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *deq_pop_front(deq_t *q) {
+    if (!deq_check(q) || q->len == 0)
+        return NULL;
+
+    void *ret = q->data[q->head];
+    q->head = (q->head + 1) & (q->max - 1);
+    q->len--;
+    return ret;
+}
+
+// Removes the last element in the specified deque. 
+//
+// PARAMS: 
+// q - the deque to remove the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *deq_pop_back(deq_t *q) {
+    if (!deq_check(q) || q->len == 0)
+        return NULL;
+    return q->data[deq_slot(q, --q->len)];
+}
+
+// Returns the element in the deque specified by the index, counting from the 
+// front. 
+//
+// PARAMS: 
+// q - the deque to get the element
+// i - the index of the element
+//
+// RET: 
+// The element, or NULL on error. 
+void *deq_get(const deq_t *q, size_t i) {
+    if (!deq_check(q) || i >= q->len)
+        return NULL;
+    return q->data[deq_slot(q, i)];
+}
+
+// Clears the specified deque, freeing all elements. 
+//
+// PARAMS: 
+// q - the deque to clear
+void deq_clear(deq_t *q) {
+    if (deq_check(q)) {
+        for (size_t i = 0; i < q->len; i++)
+            free(q->data[deq_slot(q, i)]);
+        q->head = 0;
+        q->len = 0;
+    }
+}
+
+// Frees the internal buffer in the specified deque. 
+//
+// PARAMS: 
+// q - the deque to free
+void deq_free(deq_t *q) {
+    if (deq_check(q)) {
+        deq_clear(q);
+        free(q->data);
+        q->data = NULL;
+    }
+}
+
+// Fixes the buffer of the deque, reallocates if needed. The wrapped part of 
+// the circular buffer is moved after the old end so the order is kept. 
+//
+// PARAMS: 
+// q - the deque to fix
+//
+// RET: 
+// True if the deque has enough storage for one more element, false 
+// otherwise. 
+static _Bool deq_fix(deq_t *q) {
+    if (q->len < q->max)
+        return true;    // space enough
+    if (q->max > SIZE_MAX / (2 * sizeof(void *)))
+        return false;
+
+    void **temp = realloc(q->data, 2 * q->max * (sizeof *temp));
+    if (temp == NULL)
+        return false;
+
+    size_t wrap = q->head;  // full, so [0, head) is the wrapped tail
+    if (wrap != 0)
+        memcpy(temp + q->max, temp, wrap * sizeof(void *));
+    q->data = temp;
+    q->max *= 2;
+    return true;
+}
+
+// Checks whether the deque is valid. 
+//
+// PARAMS: 
+// q - the deque to check
+//
+// RET: 
+// True if the deque is in valid state, false otherwise. 
+static inline _Bool deq_check(const deq_t *q) {
+    return (q != NULL && q->data != NULL);
+}
+
+// Maps an index counted from the front to a slot in the buffer. 
+//
+// PARAMS: 
+// q - the deque to map
+// i - the index counted from the front
+//
+// RET: 
+// The slot in the buffer. 
+static inline size_t deq_slot(const deq_t *q, size_t i) {
+    return (q->head + i) & (q->max - 1);
+}
+
+// Returns a copy of the specified element. 
+//
+// PARAMS: 
+// d - the element to copy
+// n - the size of the element
+static void *deq_new_elem(const void *d, size_t n) {
+    if (d == NULL || n == 0)
+        return NULL;
+
+    void *ret = malloc(n);
+    if (ret != NULL)
+        memcpy(ret, d, n);
+    return ret;
+}
+
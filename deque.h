@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////
+// deque.h
+// Double-ended queue implementation in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEQUE_H
+#define DEQUE_H
+#include "vector.h"
+
+// The double-ended queue, a circular buffer of element copies. 
+typedef struct deque_t {
+    void **data;            // internal data
+    size_t head;            // index of the first element in data
+    size_t len;             // current length
+    size_t max;             // maximum length, always a power of two
+} deq_t;
+
+// Initialises the specified deque. 
+//
+// PARAMS: 
+// q - the deque to initialise
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int deq_init(deq_t *q);
+
+// Adds a new element to the front of the specified deque. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// q - the deque to add the element
+// d - the element to add
+// n - the size of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int deq_push_front(deq_t *q, const void *d, size_t n);
+
+// Adds a new element to the back of the specified deque. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// q - the deque to add the element
+// d - the element to add
+// n - the size of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int deq_push_back(deq_t *q, const void *d, size_t n);
+
+// Removes the first element in the specified deque. 
+//
+// PARAMS: 
+// q - the deque to remove the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *deq_pop_front(deq_t *q);
+
+// Removes the last element in the specified deque. 
+//
+// PARAMS: 
+// q - the deque to remove the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *deq_pop_back(deq_t *q);
+
+// Returns the element in the deque specified by the index, counting from the 
+// front. 
+//
+// PARAMS: 
+// q - the deque to get the element
+// i - the index of the element
+//
+// RET: 
+// The element, or NULL on error. 
+void *deq_get(const deq_t *q, size_t i);
+
+// Clears the specified deque, freeing all elements. 
+//
+// PARAMS: 
+// q - the deque to clear
+void deq_clear(deq_t *q);
+
+// Frees the internal buffer in the specified deque. 
+//
+// PARAMS: 
+// q - the deque to free
+void deq_free(deq_t *q);
+
+#endif
+
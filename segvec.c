@@ -0,0 +1,244 @@
+///////////////////////////////////////////////////////////////////////////////
+// segvec.c
+// Segmented vector implementation in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#include "segvec.h"
+#define BASE ((size_t)1 << SVEC_BASE_BITS)
+#define SEG_SIZE(k) (BASE << (k))
+
+static _Bool svec_fix(svec_t *s);
+static inline _Bool svec_check(const svec_t *s);
+static inline size_t svec_locate(size_t i, size_t *off);
+static void *svec_new_elem(const void *d, size_t n);
+
+// Initialises the specified segmented vector. 
+//
+// PARAMS: 
+// s - the vector to initialise
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int svec_init(svec_t *s) {
+    if (s == NULL)
+        return VEC_NULL_ERR;
+
+    int ret = VEC_GOOD;
+    for (size_t k = 0; k < SVEC_SEGS; k++)
+        s->segs[k] = NULL;
+    s->len = 0;
+    s->nsegs = 1;
+    s->segs[0] = malloc(SEG_SIZE(0) * sizeof(void *));
+    if (s->segs[0] == NULL) {
+        s->nsegs = 0;
+        ret = VEC_ALLOC_ERR;
+    }
+    return ret;
+}
+
+// Adds a new element into the specified segmented vector. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// s - the vector to add the element
+// d - the element to add
+// n - the size of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int svec_add(svec_t *s, const void *d, size_t n) {
+    if (!svec_check(s))
+        return VEC_NULL_ERR;
+    if (!svec_fix(s))
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_ALLOC_ERR;
+    void *elem = svec_new_elem(d, n);
+    if (elem != NULL) {
+        size_t off, k = svec_locate(s->len, &off);
+        s->segs[k][off] = elem;
+        s->len++;
+        ret = VEC_GOOD;
+    }
+    return ret;
+}
+
+// Inserts a new element into the specified segmented vector. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// s - the vector to insert the element
+// d - the element to insert
+// n - the size of the element
+// i - the index to insert to
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int svec_ins(svec_t *s, const void *d, size_t n, size_t i) {
+    if (!svec_check(s))
+        return VEC_NULL_ERR;
+    if (i >= s->len)
+        return svec_add(s, d, n);   // add to last if out of range
+    if (!svec_fix(s))
+        return VEC_ALLOC_ERR;
+
+    void *elem = svec_new_elem(d, n);
+    if (elem == NULL)
+        return VEC_ALLOC_ERR;
+
+    // shift up one slot, from the last segment down to the one holding i
+    size_t offi, ki = svec_locate(i, &offi);
+    size_t offl, kl = svec_locate(s->len, &offl);
+    for (size_t k = kl + 1; k-- > ki;) {
+        void **seg = s->segs[k];
+        size_t top = (k == kl) ? offl : SEG_SIZE(k) - 1;
+        size_t bot = (k == ki) ? offi : 0;
+        memmove(seg + bot + 1, seg + bot, (top - bot) * sizeof(void *));
+        if (k > ki)
+            seg[0] = s->segs[k - 1][SEG_SIZE(k - 1) - 1];
+    }
+    s->segs[ki][offi] = elem;
+    s->len++;
+    return VEC_GOOD;
+}
+
+// Returns the element in the segmented vector specified by the index. 
+//
+// PARAMS: 
+// s - the vector to get the element
+// i - the index of the element
+//
+// RET: 
+// The element, or NULL on error. 
+void *svec_get(const svec_t *s, size_t i) {
+    if (!svec_check(s) || i >= s->len)
+        return NULL;
+
+    size_t off, k = svec_locate(i, &off);
+    return s->segs[k][off];
+}
+
+// Deletes an element in the segmented vector specified by the index. 
+//
+// PARAMS: 
+// s - the vector to delete the element
+// i - the index of the element
+//
+// RET: 
+// The deleted element, or NULL on error. 
+void *svec_del(svec_t *s, size_t i) {
+    if (!svec_check(s) || i >= s->len)
+        return NULL;
+
+    // shift down one slot, from the segment holding i up to the last one
+    size_t off, k = svec_locate(i, &off);
+    size_t offl, kl = svec_locate(s->len - 1, &offl);
+    void *ret = s->segs[k][off];
+    for (; k <= kl; k++, off = 0) {
+        void **seg = s->segs[k];
+        size_t top = (k == kl) ? offl : SEG_SIZE(k) - 1;
+        memmove(seg + off, seg + off + 1, (top - off) * sizeof(void *));
+        if (k < kl)
+            seg[top] = s->segs[k + 1][0];
+    }
+    s->len--;
+    return ret;
+}
+
+// Clears the specified segmented vector, freeing all elements. The segments 
+// are kept for reuse. 
+//
+// PARAMS: 
+// s - the vector to clear
+void svec_clear(svec_t *s) {
+    if (svec_check(s)) {
+        for (size_t i = 0; i < s->len; i++) {
+            size_t off, k = svec_locate(i, &off);
+            free(s->segs[k][off]);
+        }
+        s->len = 0;
+    }
+}
+
+// Frees the segments in the specified segmented vector. 
+//
+// PARAMS: 
+// s - the vector to free
+void svec_free(svec_t *s) {
+    if (svec_check(s)) {
+        svec_clear(s);
+        for (size_t k = 0; k < s->nsegs; k++) {
+            free(s->segs[k]);
+            s->segs[k] = NULL;
+        }
+        s->nsegs = 0;
+    }
+}
+
+// Fixes the segments of the vector, adds a segment if needed. Existing 
+// segments are never moved. 
+//
+// PARAMS: 
+// s - the vector to fix
+//
+// RET: 
+// True if the vector has enough storage for one more element, false 
+// otherwise. 
+static _Bool svec_fix(svec_t *s) {
+    size_t off, k = svec_locate(s->len, &off);
+    if (k < s->nsegs)
+        return true;    // space enough
+    if (k >= SVEC_SEGS)
+        return false;
+
+    void **seg = malloc(SEG_SIZE(k) * sizeof(void *));
+    if (seg == NULL)
+        return false;
+    s->segs[s->nsegs++] = seg;
+    return true;
+}
+
+// Checks whether the segmented vector is valid. 
+//
+// PARAMS: 
+// s - the vector to check
+//
+// RET: 
+// True if the vector is in valid state, false otherwise. 
+static inline _Bool svec_check(const svec_t *s) {
+    return (s != NULL && s->nsegs != 0);
+}
+
+// Maps an index to its segment and the offset inside that segment. 
+//
+// PARAMS: 
+// i   - the index
+// off - where to store the offset
+//
+// RET: 
+// The index of the segment. 
+static inline size_t svec_locate(size_t i, size_t *off) {
+    unsigned long long x = (unsigned long long)i + BASE;
+    size_t h = (size_t)(63 - __builtin_clzll(x));
+    *off = (size_t)(x - (1ULL << h));
+    return h - SVEC_BASE_BITS;
+}
+
+// Returns a copy of the specified element. 
+//
+// PARAMS: 
+// d - the element to copy
+// n - the size of the element
+static void *svec_new_elem(const void *d, size_t n) {
+    if (d == NULL || n == 0)
+        return NULL;
+
+    void *ret = malloc(n);
+    if (ret != NULL)
+        memcpy(ret, d, n);
+    return ret;
+}
+
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// segvec.h
+// Segmented vector implementation in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SEGVEC_H
+#define SEGVEC_H
+#include "vector.h"
+
+#define SVEC_BASE_BITS 4    // the first segment holds 1 << SVEC_BASE_BITS
+#define SVEC_SEGS 48        // size of the segment directory
+
+// The segmented vector. Segment k holds (1 << SVEC_BASE_BITS) << k slots, 
+// growing adds a segment without moving the existing ones. 
+typedef struct segvec_t {
+    void **segs[SVEC_SEGS]; // segment directory
+    size_t len;             // current length
+    size_t nsegs;           // number of allocated segments
+} svec_t;
+
+// Initialises the specified segmented vector. 
+//
+// PARAMS: 
+// s - the vector to initialise
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int svec_init(svec_t *s);
+
+// Adds a new element into the specified segmented vector. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// s - the vector to add the element
+// d - the element to add
+// n - the size of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int svec_add(svec_t *s, const void *d, size_t n);
+
+// Inserts a new element into the specified segmented vector. The new element 
+// will be copied. 
+//
+// PARAMS: 
+// s - the vector to insert the element
+// d - the element to insert
+// n - the size of the element
+// i - the index to insert to
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int svec_ins(svec_t *s, const void *d, size_t n, size_t i);
+
+// Returns the element in the segmented vector specified by the index. 
+//
+// PARAMS: 
+// s - the vector to get the element
+// i - the index of the element
+//
+// RET: 
+// The element, or NULL on error. 
+void *svec_get(const svec_t *s, size_t i);
+
+// Deletes an element in the segmented vector specified by the index. 
+//
+// PARAMS: 
+// s - the vector to delete the element
+// i - the index of the element
+//
+// RET: 
+// The deleted element, or NULL on error. 
+void *svec_del(svec_t *s, size_t i);
+
+// Clears the specified segmented vector, freeing all elements. The segments 
+// are kept for reuse. 
+//
+// PARAMS: 
+// s - the vector to clear
+void svec_clear(svec_t *s);
+
+// Frees the segments in the specified segmented vector. 
+//
+// PARAMS: 
+// s - the vector to free
+void svec_free(svec_t *s);
+
+#endif
+
@@ -0,0 +1,323 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecbatch.c
+// Batched vector mutations in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#include "vecbatch.h"
+#define DEF_OPS 16
+#define DEF_BUF 256
+
+// A queued insert or delete. 
+struct vec_batch_op {
+    size_t i;               // the index in the vector
+    size_t seq;             // the queue order, keeps the sort stable
+    size_t off;             // offset of the element copy in buf
+    size_t n;               // size of the element, zero for a delete
+};
+
+static _Bool batch_grow(const vec_alloc_t *a, void **p, size_t *max, 
+        size_t need, size_t size, size_t def);
+static int batch_push(vec_batch_t *b, size_t i, size_t off, size_t n);
+static int batch_apply(vec_batch_t *b);
+static int batch_cmp(const void *a, const void *b);
+static void batch_task(void *arg);
+
+// Initialises the specified batch for the vector. 
+//
+// PARAMS: 
+// b - the batch to initialise
+// v - the vector the batch mutates
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_init(vec_batch_t *b, vec_t *v) {
+    if (b == NULL || v == NULL || v->data == NULL)
+        return VEC_NULL_ERR;
+
+    b->v = v;
+    b->alloc = v->alloc;
+    b->ops = NULL;
+    b->len = 0;
+    b->max = 0;
+    b->buf = NULL;
+    b->used = 0;
+    b->cap = 0;
+    b->done = NULL;
+    b->ctx = NULL;
+    return VEC_GOOD;
+}
+
+// Queues an insert of a new element before the element at index i, or at the 
+// end if i is the length. The new element is copied now and copied again 
+// into the vector on commit. Inserts at the same index keep their order. 
+//
+// PARAMS: 
+// b - the batch to queue to
+// d - the element to insert
+// n - the size of the element
+// i - the index to insert before
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_ins(vec_batch_t *b, const void *d, size_t n, size_t i) {
+    if (b == NULL || d == NULL)
+        return VEC_NULL_ERR;
+    if (n == 0)
+        return VEC_RANGE_ERR;
+    if (n > SIZE_MAX - b->used)
+        return VEC_ALLOC_ERR;
+
+    void *buf = b->buf;
+    if (!batch_grow(b->alloc, &buf, &b->cap, b->used + n, 1, DEF_BUF))
+        return VEC_ALLOC_ERR;
+    b->buf = buf;
+
+    int ret = batch_push(b, i, b->used, n);
+    if (ret == VEC_GOOD) {
+        memcpy(b->buf + b->used, d, n);
+        b->used += n;
+    }
+    return ret;
+}
+
+// Queues a delete of the element at index i, which is freed on commit. 
+//
+// PARAMS: 
+// b - the batch to queue to
+// i - the index of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_del(vec_batch_t *b, size_t i) {
+    if (b == NULL)
+        return VEC_NULL_ERR;
+    return batch_push(b, i, 0, 0);
+}
+
+// Applies every queued operation to the vector and empties the batch. The 
+// operations are sorted by index and the vector is rebuilt in one linear 
+// pass, O(n + k log k) for k operations. Nothing is changed in the vector if 
+// an index is out of range, an element is deleted twice or memory runs out. 
+// The batch is emptied either way. 
+//
+// PARAMS: 
+// b - the batch to commit
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_commit(vec_batch_t *b) {
+    if (b == NULL || b->v == NULL || b->v->data == NULL)
+        return VEC_NULL_ERR;
+
+    int ret = (b->len == 0) ? VEC_GOOD : batch_apply(b);
+    vec_batch_clear(b);
+    return ret;
+}
+
+// Commits the batch on the thread pool without waiting, as vec_batch_commit. 
+// The completion receives the batch, the result of the commit and the 
+// context. Neither the batch nor the vector may be used until then. 
+//
+// PARAMS: 
+// b    - the batch to commit
+// pool - the thread pool, NULL to commit on the caller
+// done - the completion, may be NULL
+// ctx  - the context passed to the completion
+//
+// RET: 
+// Zero if the commit was started, non-zero on error. 
+int vec_batch_commit_async(vec_batch_t *b, vec_pool_t *pool, 
+        void (*done)(vec_batch_t *, int, void *), void *ctx) {
+    if (b == NULL || b->v == NULL || b->v->data == NULL)
+        return VEC_NULL_ERR;
+
+    b->done = done;
+    b->ctx = ctx;
+    if (pool == NULL) {
+        batch_task(b);
+        return VEC_GOOD;
+    }
+    return vec_pool_submit(pool, batch_task, b);
+}
+
+// Discards every queued operation. 
+//
+// PARAMS: 
+// b - the batch to clear
+void vec_batch_clear(vec_batch_t *b) {
+    if (b != NULL) {
+        b->len = 0;
+        b->used = 0;
+    }
+}
+
+// Frees the specified batch, discarding every queued operation. 
+//
+// PARAMS: 
+// b - the batch to free
+void vec_batch_free(vec_batch_t *b) {
+    if (b != NULL) {
+        if (b->ops != NULL)
+            b->alloc->release(b->alloc->ctx, b->ops);
+        if (b->buf != NULL)
+            b->alloc->release(b->alloc->ctx, b->buf);
+        b->ops = NULL;
+        b->buf = NULL;
+        b->len = 0;
+        b->max = 0;
+        b->used = 0;
+        b->cap = 0;
+    }
+}
+
+// Grows a buffer by doubling until it holds need items, using the allocator. 
+//
+// PARAMS: 
+// a    - the allocator
+// p    - the buffer to grow, may point to NULL
+// max  - the number of items the buffer holds
+// need - the number of items needed
+// size - the size of each item
+// def  - the number of items of a new buffer
+//
+// RET: 
+// True if the buffer holds need items, false otherwise. 
+static _Bool batch_grow(const vec_alloc_t *a, void **p, size_t *max, 
+        size_t need, size_t size, size_t def) {
+    if (need <= *max)
+        return true;
+
+    size_t n = (*max == 0) ? def : *max;
+    while (n < need)
+        n = (n > SIZE_MAX / 2) ? need : 2 * n;
+    if (n > SIZE_MAX / size)
+        return false;
+
+    void *temp = (*p == NULL) ? a->alloc(a->ctx, n * size) 
+            : a->resize(a->ctx, *p, n * size);
+    if (temp == NULL)
+        return false;
+    *p = temp;
+    *max = n;
+    return true;
+}
+
+// Queues one operation. 
+//
+// PARAMS: 
+// b   - the batch to queue to
+// i   - the index in the vector
+// off - offset of the element copy in buf
+// n   - size of the element, zero for a delete
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int batch_push(vec_batch_t *b, size_t i, size_t off, size_t n) {
+    void *ops = b->ops;
+    if (!batch_grow(b->alloc, &ops, &b->max, b->len + 1, sizeof *b->ops, 
+            DEF_OPS))
+        return VEC_ALLOC_ERR;
+    b->ops = ops;
+
+    struct vec_batch_op *op = &b->ops[b->len];
+    op->i = i;
+    op->seq = b->len++;
+    op->off = off;
+    op->n = n;
+    return VEC_GOOD;
+}
+
+// Applies the queued operations of a batch to its vector. The new elements 
+// are copied to the end of the vector first, then every slot is moved to its 
+// final place in one pass, with the deleted elements gathered at the end to 
+// be freed by vec_delrange. 
+//
+// PARAMS: 
+// b - the batch to apply, not empty
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int batch_apply(vec_batch_t *b) {
+    vec_t *v = b->v;
+    struct vec_batch_op *ops = b->ops;
+    size_t k = b->len, len = v->len, nins = 0, ndel = 0, last = 0;
+    qsort(ops, k, sizeof *ops, batch_cmp);
+
+    // check every index before touching the vector
+    for (size_t j = 0; j < k; j++) {
+        if (ops[j].n != 0) {
+            if (ops[j].i > len)
+                return VEC_RANGE_ERR;
+            nins++;
+        } else {
+            if (ops[j].i >= len || (ndel != 0 && ops[j].i == last))
+                return VEC_RANGE_ERR;
+            last = ops[j].i;
+            ndel++;
+        }
+    }
+    if (nins > SIZE_MAX / sizeof(void *) - len)
+        return VEC_ALLOC_ERR;
+
+    void **tmp = v->alloc->alloc(v->alloc->ctx, (len + nins) * sizeof *tmp);
+    if (tmp == NULL)
+        return VEC_ALLOC_ERR;
+    for (size_t j = 0; j < k; j++) {
+        if (ops[j].n == 0)
+            continue;
+        int ret = vec_add(v, b->buf + ops[j].off, ops[j].n);
+        if (ret != VEC_GOOD) {
+            vec_delrange(v, len, v->len - len);     // roll back the copies
+            v->alloc->release(v->alloc->ctx, tmp);
+            return ret;
+        }
+    }
+
+    size_t w = 0, t = len + nins - ndel, add = len, j = 0;
+    for (size_t r = 0; r <= len; r++) {
+        _Bool gone = false;
+        for (; j < k && ops[j].i == r; j++) {
+            if (ops[j].n != 0)
+                tmp[w++] = v->data[add++];
+            else
+                gone = true;
+        }
+        if (r < len)
+            tmp[gone ? t++ : w++] = v->data[r];
+    }
+    memcpy(v->data, tmp, (len + nins) * sizeof *tmp);
+    v->alloc->release(v->alloc->ctx, tmp);
+    vec_delrange(v, len + nins - ndel, ndel);
+    return VEC_GOOD;
+}
+
+// Orders two operations by index, then by queue order. 
+//
+// PARAMS: 
+// a - the first operation
+// b - the second operation
+//
+// RET: 
+// Negative, zero or positive as a is before, equal to or after b. 
+static int batch_cmp(const void *a, const void *b) {
+    const struct vec_batch_op *x = a, *y = b;
+    if (x->i != y->i)
+        return (x->i < y->i) ? -1 : 1;
+    return (x->seq < y->seq) ? -1 : (x->seq > y->seq);
+}
+
+// Commits a batch and calls its completion, the thread pool task of 
+// vec_batch_commit_async. 
+//
+// PARAMS: 
+// arg - the batch to commit
+static void batch_task(void *arg) {
+    vec_batch_t *b = arg;
+    int ret = vec_batch_commit(b);
+    if (b->done != NULL)
+        b->done(b, ret, b->ctx);
+}
+
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecbatch.h
+// Batched vector mutations in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECBATCH_H
+#define VECBATCH_H
+#include "vector.h"
+#include "vecpool.h"
+
+// A queued insert or delete. 
+struct vec_batch_op;
+
+// The batch of mutations. Inserts and deletes are queued against the indices 
+// the vector has when the batch is committed, and applied together by 
+// vec_batch_commit in one pass over the vector instead of one shift each. 
+// The queues and the scratch of a commit come from the vector's allocator. 
+typedef struct vec_batch_t {
+    vec_t *v;                       // the vector to mutate
+    const vec_alloc_t *alloc;       // allocator, the vector's at init
+    struct vec_batch_op *ops;       // queued operations
+    size_t len;                     // number of queued operations
+    size_t max;                     // maximum number of queued operations
+    unsigned char *buf;             // copies of the inserted elements
+    size_t used;                    // bytes used in buf
+    size_t cap;                     // bytes available in buf
+    void (*done)(struct vec_batch_t *, int, void *);    // async completion
+    void *ctx;                      // the context of the completion
+} vec_batch_t;
+
+// Initialises the specified batch for the vector. 
+//
+// PARAMS: 
+// b - the batch to initialise
+// v - the vector the batch mutates
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_init(vec_batch_t *b, vec_t *v);
+
+// Queues an insert of a new element before the element at index i, or at the 
+// end if i is the length. The new element is copied now and copied again 
+// into the vector on commit. Inserts at the same index keep their order. 
+//
+// PARAMS: 
+// b - the batch to queue to
+// d - the element to insert
+// n - the size of the element
+// i - the index to insert before
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_ins(vec_batch_t *b, const void *d, size_t n, size_t i);
+
+// Queues a delete of the element at index i, which is freed on commit. 
+//
+// PARAMS: 
+// b - the batch to queue to
+// i - the index of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_del(vec_batch_t *b, size_t i);
+
+// Applies every queued operation to the vector and empties the batch. The 
+// operations are sorted by index and the vector is rebuilt in one linear 
+// pass, O(n + k log k) for k operations. Nothing is changed in the vector if 
+// an index is out of range, an element is deleted twice or memory runs out. 
+// The batch is emptied either way. 
+//
+// PARAMS: 
+// b - the batch to commit
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_batch_commit(vec_batch_t *b);
+
+// Commits the batch on the thread pool without waiting, as vec_batch_commit. 
+// The completion receives the batch, the result of the commit and the 
+// context. Neither the batch nor the vector may be used until then. 
+//
+// PARAMS: 
+// b    - the batch to commit
+// pool - the thread pool, NULL to commit on the caller
+// done - the completion, may be NULL
+// ctx  - the context passed to the completion
+//
+// RET: 
+// Zero if the commit was started, non-zero on error. 
+int vec_batch_commit_async(vec_batch_t *b, vec_pool_t *pool, 
+        void (*done)(vec_batch_t *, int, void *), void *ctx);
+
+// Discards every queued operation. 
+//
+// PARAMS: 
+// b - the batch to clear
+void vec_batch_clear(vec_batch_t *b);
+
+// Frees the specified batch, discarding every queued operation. 
+//
+// PARAMS: 
+// b - the batch to free
+void vec_batch_free(vec_batch_t *b);
+
+#endif
+
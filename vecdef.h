@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecdef.h
+// Type-specialised vector generator in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECDEF_H
+#define VECDEF_H
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "vector.h"
+
+// The default ordering used by VEC_DEFINE. 
+#define VEC_DEF_LESS(a, b) ((a) < (b))
+
+// Below this many elements the sort switches to insertion sort. 
+#define VEC_DEF_ISORT 16
+
+// The initial maximum length of a generated vector. 
+#define VEC_DEF_MAX 10
+
+// Defines the vector type vec_T_t holding elements of type T by value, the 
+// element ordering is the < operator. T must be a single token, use 
+// VEC_DEFINE_CMP for types such as "unsigned int" or "struct foo". 
+//
+// PARAMS: 
+// T - the element type
+#define VEC_DEFINE(T) VEC_DEFINE_CMP(T, T, VEC_DEF_LESS)
+
+// Defines the vector type vec_name_t holding elements of type T by value. The 
+// generated functions are: 
+//
+// int  vec_name_init(vec_name_t *v)
+// int  vec_name_reserve(vec_name_t *v, size_t n)
+// int  vec_name_push(vec_name_t *v, T d)
+// T    vec_name_get(const vec_name_t *v, size_t i)     (i must be < len)
+// int  vec_name_pop(vec_name_t *v, T *out)
+// void vec_name_sort(vec_name_t *v)
+// void vec_name_clear(vec_name_t *v)
+// void vec_name_free(vec_name_t *v)
+//
+// PARAMS: 
+// name - the name used in the generated identifiers
+// T    - the element type
+// less - function or function-like macro, less(a, b) is true if a < b
+#define VEC_DEFINE_CMP(name, T, less)                                        \
+typedef struct vec_##name##_t {                                              \
+    T *data;                /* internal data */                              \
+    size_t len;             /* current length */                             \
+    size_t max;             /* maximum length */                             \
+} vec_##name##_t;                                                            \
+                                                                             \
+static inline int vec_##name##_init(vec_##name##_t *v) {                     \
+    if (v == NULL)                                                           \
+        return VEC_NULL_ERR;                                                 \
+    v->len = 0;                                                              \
+    v->max = VEC_DEF_MAX;                                                    \
+    v->data = malloc(v->max * sizeof(T));                                    \
+    return (v->data == NULL) ? VEC_ALLOC_ERR : VEC_GOOD;                     \
+}                                                                            \
+                                                                             \
+static inline int vec_##name##_reserve(vec_##name##_t *v, size_t n) {        \
+    if (v == NULL || v->data == NULL)                                        \
+        return VEC_NULL_ERR;                                                 \
+    if (n <= v->max)                                                         \
+        return VEC_GOOD;                                                     \
+    if (n > SIZE_MAX / sizeof(T))                                            \
+        return VEC_ALLOC_ERR;                                                \
+    T *res = realloc(v->data, n * sizeof(T));                                \
+    if (res == NULL)                                                         \
+        return VEC_ALLOC_ERR;                                                \
+    v->data = res;                                                           \
+    v->max = n;                                                              \
+    return VEC_GOOD;                                                         \
+}                                                                            \
+                                                                             \
+static inline int vec_##name##_push(vec_##name##_t *v, T d) {                \
+    if (v == NULL || v->data == NULL)                                        \
+        return VEC_NULL_ERR;                                                 \
+    if (v->len == v->max) {                                                  \
+        size_t max = (v->max > SIZE_MAX / 2) ? SIZE_MAX : 2 * v->max;        \
+        if (max == v->max)                                                   \
+            return VEC_ALLOC_ERR;                                            \
+        int ret = vec_##name##_reserve(v, max);                              \
+        if (ret != VEC_GOOD)                                                 \
+            return ret;                                                      \
+    }                                                                        \
+    v->data[v->len++] = d;                                                   \
+    return VEC_GOOD;                                                         \
+}                                                                            \
+                                                                             \
+static inline T vec_##name##_get(const vec_##name##_t *v, size_t i) {        \
+    return v->data[i];                                                       \
+}                                                                            \
+                                                                             \
+static inline int vec_##name##_pop(vec_##name##_t *v, T *out) {              \
+    if (v == NULL || v->data == NULL)                                        \
+        return VEC_NULL_ERR;                                                 \
+    if (v->len == 0)                                                         \
+        return VEC_RANGE_ERR;                                                \
+    v->len--;                                                                \
+    if (out != NULL)                                                         \
+        *out = v->data[v->len];                                              \
+    return VEC_GOOD;                                                         \
+}                                                                            \
+                                                                             \
+static inline void vec_##name##_isort(T *a, size_t n) {                      \
+    for (size_t i = 1; i < n; i++) {                                         \
+        T x = a[i];                                                          \
+        size_t j = i;                                                        \
+        for (; j > 0 && less(x, a[j - 1]); j--)                              \
+            a[j] = a[j - 1];                                                 \
+        a[j] = x;                                                            \
+    }                                                                        \
+}                                                                            \
+                                                                             \
+static inline void vec_##name##_sift(T *a, size_t i, size_t n) {             \
+    T x = a[i];                                                              \
+    for (size_t c = 2 * i + 1; c < n; c = 2 * i + 1) {                       \
+        if (c + 1 < n && less(a[c], a[c + 1]))                               \
+            c++;                                                             \
+        if (!less(x, a[c]))                                                  \
+            break;                                                           \
+        a[i] = a[c];                                                         \
+        i = c;                                                               \
+    }                                                                        \
+    a[i] = x;                                                                \
+}                                                                            \
+                                                                             \
+static inline void vec_##name##_hsort(T *a, size_t n) {                      \
+    for (size_t i = n / 2; i > 0; i--)                                       \
+        vec_##name##_sift(a, i - 1, n);                                      \
+    for (size_t i = n - 1; i > 0; i--) {                                     \
+        T x = a[0];                                                          \
+        a[0] = a[i];                                                         \
+        a[i] = x;                                                            \
+        vec_##name##_sift(a, 0, i);                                          \
+    }                                                                        \
+}                                                                            \
+                                                                             \
+static inline void vec_##name##_intro(T *a, size_t n, size_t depth) {        \
+    while (n > VEC_DEF_ISORT) {                                              \
+        if (depth-- == 0) {                                                  \
+            vec_##name##_hsort(a, n);  /* too many bad pivots */             \
+            return;                                                          \
+        }                                                                    \
+                                                                             \
+        /* median of three, pivot ends up in the middle */                   \
+        size_t m = n / 2;                                                    \
+        T x;                                                                 \
+        if (less(a[m], a[0])) { x = a[m]; a[m] = a[0]; a[0] = x; }           \
+        if (less(a[n - 1], a[m])) { x = a[m]; a[m] = a[n-1]; a[n-1] = x; }   \
+        if (less(a[m], a[0])) { x = a[m]; a[m] = a[0]; a[0] = x; }           \
+                                                                             \
+        T p = a[m];                                                          \
+        size_t i = 0, j = n - 1;                                             \
+        for (;;) {                                                           \
+            while (less(a[i], p))                                            \
+                i++;                                                         \
+            while (less(p, a[j]))                                            \
+                j--;                                                         \
+            if (i >= j)                                                      \
+                break;                                                       \
+            x = a[i];                                                        \
+            a[i++] = a[j];                                                   \
+            a[j--] = x;                                                      \
+        }                                                                    \
+                                                                             \
+        /* recurse into the smaller half, loop on the larger */              \
+        size_t left = j + 1;                                                 \
+        if (left < n - left) {                                               \
+            vec_##name##_intro(a, left, depth);                              \
+            a += left;                                                       \
+            n -= left;                                                       \
+        } else {                                                             \
+            vec_##name##_intro(a + left, n - left, depth);                   \
+            n = left;                                                        \
+        }                                                                    \
+    }                                                                        \
+    vec_##name##_isort(a, n);                                                \
+}                                                                            \
+                                                                             \
+static inline void vec_##name##_sort(vec_##name##_t *v) {                    \
+    if (v == NULL || v->data == NULL || v->len < 2)                          \
+        return;                                                              \
+    size_t depth = 0;                                                        \
+    for (size_t n = v->len; n > 1; n >>= 1)                                  \
+        depth += 2;                                                          \
+    vec_##name##_intro(v->data, v->len, depth);                              \
+}                                                                            \
+                                                                             \
+static inline void vec_##name##_clear(vec_##name##_t *v) {                   \
+    if (v != NULL)                                                           \
+        v->len = 0;                                                          \
+}                                                                            \
+                                                                             \
+static inline void vec_##name##_free(vec_##name##_t *v) {                    \
+    if (v != NULL) {                                                         \
+        free(v->data);                                                       \
+        v->data = NULL;                                                      \
+        v->len = 0;                                                          \
+        v->max = 0;                                                          \
+    }                                                                        \
+}
+
+#endif
+
@@ -0,0 +1,287 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecio.c
+// Streaming vector serialisation with vectored I/O in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#define _POSIX_C_SOURCE 200809L
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "vecio.h"
+#define IO_MAGIC "VECSTRM1"
+#define IO_HDR 24           // magic, element count, payload size
+#define IO_PRE 8            // length prefix of each element
+#define IO_BUF 65536        // read buffer size
+#define IO_TRUST (1 << 24)  // bytes reserved from the header before payload
+
+// iovecs handed to one writev call. 
+#if defined(IOV_MAX) && IOV_MAX < 1024
+#define IO_BATCH IOV_MAX
+#else
+#define IO_BATCH 1024
+#endif
+
+// Buffered reader over a file descriptor. 
+typedef struct io_reader_t {
+    int fd;                 // the file descriptor
+    unsigned char *buf;     // the read buffer
+    size_t cap;             // size of the buffer
+    size_t pos;             // first unconsumed byte
+    size_t end;             // end of the buffered bytes
+    uint64_t left;          // bytes of the message not read from fd yet
+} io_reader_t;
+
+static void io_put64(unsigned char *p, uint64_t x);
+static uint64_t io_get64(const unsigned char *p);
+static int io_writev(int fd, struct iovec *iov, int n);
+static int io_fill(io_reader_t *r, size_t n);
+
+// Writes every element of the specified vector to a file descriptor. The 
+// stream starts with the element count and the total payload size, then 
+// holds each element prefixed by its length. Integers are little-endian. 
+// Elements are gathered with writev in batches, so a message takes a handful 
+// of system calls instead of one per element. 
+//
+// PARAMS: 
+// v    - the vector to write
+// fd   - the file descriptor to write to
+// size - returns the size in bytes of an element, receives the context
+// ctx  - the context passed to the size function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_write_fd(const vec_t *v, int fd, 
+        size_t (*size)(const void *, void *), void *ctx) {
+    if (v == NULL || v->data == NULL || size == NULL)
+        return VEC_NULL_ERR;
+    if (v->len > SIZE_MAX / IO_PRE)
+        return VEC_ALLOC_ERR;
+
+    // the prefixes double as the record of each size, ask for them once
+    unsigned char *pre = malloc((v->len == 0) ? 1 : v->len * IO_PRE);
+    if (pre == NULL)
+        return VEC_ALLOC_ERR;
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < v->len; i++) {
+        if (v->data[i] == NULL)
+            continue;   // dead slot, not sent
+        size_t n = size(v->data[i], ctx);
+        if (n == 0) {
+            free(pre);
+            return VEC_RANGE_ERR;
+        }
+        io_put64(pre + i * IO_PRE, n);
+        total += n;
+    }
+
+    unsigned char hdr[IO_HDR];
+    memcpy(hdr, IO_MAGIC, 8);
+    io_put64(hdr + 8, v->len - v->ndead);
+    io_put64(hdr + 16, total);
+
+    struct iovec iov[IO_BATCH];
+    iov[0].iov_base = hdr;
+    iov[0].iov_len = IO_HDR;
+    int cnt = 1, ret = VEC_GOOD;
+    for (size_t i = 0; i < v->len && ret == VEC_GOOD; i++) {
+        if (v->data[i] == NULL)
+            continue;
+        if (cnt > IO_BATCH - 2) {
+            ret = io_writev(fd, iov, cnt);
+            cnt = 0;
+        }
+        iov[cnt].iov_base = pre + i * IO_PRE;
+        iov[cnt++].iov_len = IO_PRE;
+        iov[cnt].iov_base = v->data[i];
+        iov[cnt++].iov_len = (size_t)io_get64(pre + i * IO_PRE);
+    }
+    if (ret == VEC_GOOD)
+        ret = io_writev(fd, iov, cnt);
+    free(pre);
+    return ret;
+}
+
+// Initialises the specified vector from a stream written by vec_write_fd. 
+// The vector is an arena vector whose element copies are carved from a 
+// single slab sized from the stream header, when the header asks for at most 
+// 16 MiB. Larger messages grow the vector and the arena as the payload 
+// arrives, so a bad header cannot force large allocations. Nothing past the 
+// end of the message is read, so messages may follow each other on the same 
+// file descriptor. 
+//
+// PARAMS: 
+// v  - the vector to initialise
+// fd - the file descriptor to read from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_read_fd(vec_t *v, int fd) {
+    if (v == NULL)
+        return VEC_NULL_ERR;
+
+    io_reader_t r = { fd, malloc(IO_BUF), IO_BUF, 0, 0, IO_HDR };
+    if (r.buf == NULL)
+        return VEC_ALLOC_ERR;
+
+    int ret = io_fill(&r, IO_HDR);
+    if (ret != VEC_GOOD) {
+        free(r.buf);
+        return ret;
+    }
+    if (memcmp(r.buf, IO_MAGIC, 8) != 0) {
+        free(r.buf);
+        return VEC_IO_ERR;
+    }
+
+    // every element takes at least one byte, so count is at most total
+    uint64_t count = io_get64(r.buf + 8);
+    uint64_t total = io_get64(r.buf + 16);
+    r.pos = IO_HDR;
+    if (count > total || count > (UINT64_MAX - total) / IO_PRE) {
+        free(r.buf);
+        return VEC_IO_ERR;
+    }
+    r.left = count * IO_PRE + total;
+
+    // every copy is rounded up to the arena alignment, size the slab for it
+    uint64_t slab = IO_TRUST, pad = VEC_ARENA_ALIGN - 1;
+    if (total <= IO_TRUST && count <= (IO_TRUST - total) / pad)
+        slab = total + count * pad;
+    ret = vec_init_arena(v, (size_t)slab);
+    if (ret != VEC_GOOD) {
+        free(r.buf);
+        return ret;
+    }
+    if (count != 0)
+        ret = vec_reserve(v, (count < IO_TRUST / sizeof(void *)) 
+                ? (size_t)count : IO_TRUST / sizeof(void *));
+
+    uint64_t seen = 0;
+    for (uint64_t i = 0; i < count && ret == VEC_GOOD; i++) {
+        if ((ret = io_fill(&r, IO_PRE)) != VEC_GOOD)
+            break;
+        uint64_t n = io_get64(r.buf + r.pos);
+        r.pos += IO_PRE;
+        if (n == 0 || n > total - seen || n > SIZE_MAX) {
+            ret = VEC_IO_ERR;   // disagrees with the header
+            break;
+        }
+        if ((ret = io_fill(&r, (size_t)n)) != VEC_GOOD)
+            break;
+        ret = vec_add(v, r.buf + r.pos, (size_t)n);
+        r.pos += (size_t)n;
+        seen += n;
+    }
+    if (ret == VEC_GOOD && seen != total)
+        ret = VEC_IO_ERR;
+    if (ret != VEC_GOOD)
+        vec_free(v);
+    free(r.buf);
+    return ret;
+}
+
+// Encodes a 64-bit integer in little-endian order. 
+//
+// PARAMS: 
+// p - where to store the 8 bytes
+// x - the integer to encode
+static void io_put64(unsigned char *p, uint64_t x) {
+    for (int i = 0; i < 8; i++)
+        p[i] = (unsigned char)(x >> (8 * i));
+}
+
+// Decodes a 64-bit little-endian integer. 
+//
+// PARAMS: 
+// p - the 8 bytes to decode
+//
+// RET: 
+// The decoded integer. 
+static uint64_t io_get64(const unsigned char *p) {
+    uint64_t x = 0;
+    for (int i = 0; i < 8; i++)
+        x |= (uint64_t)p[i] << (8 * i);
+    return x;
+}
+
+// Writes every byte described by the iovecs, resuming after short writes. 
+// The iovecs are consumed in the process. 
+//
+// PARAMS: 
+// fd  - the file descriptor to write to
+// iov - the buffers to write
+// n   - the number of buffers
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int io_writev(int fd, struct iovec *iov, int n) {
+    while (n > 0) {
+        ssize_t w = writev(fd, iov, n);
+        if (w < 0) {
+            if (errno == EINTR)
+                continue;
+            return VEC_IO_ERR;
+        }
+
+        size_t left = (size_t)w;
+        while (n > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (unsigned char *)iov->iov_base + left;
+            iov->iov_len -= left;
+        }
+    }
+    return VEC_GOOD;
+}
+
+// Makes sure at least n unconsumed bytes are buffered. The buffer grows as 
+// the bytes arrive if n does not fit, and no read goes past the end of the 
+// message. 
+//
+// PARAMS: 
+// r - the reader
+// n - the number of bytes needed
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int io_fill(io_reader_t *r, size_t n) {
+    if (r->end - r->pos >= n)
+        return VEC_GOOD;
+
+    memmove(r->buf, r->buf + r->pos, r->end - r->pos);
+    r->end -= r->pos;
+    r->pos = 0;
+    if (n - r->end > r->left)
+        return VEC_IO_ERR;  // past the end of the message
+
+    while (r->end < n) {
+        if (r->end == r->cap) {
+            size_t cap = (n - r->cap <= r->cap) ? n : 2 * r->cap;
+            unsigned char *res = realloc(r->buf, cap);
+            if (res == NULL)
+                return VEC_ALLOC_ERR;
+            r->buf = res;
+            r->cap = cap;
+        }
+
+        size_t want = r->cap - r->end;
+        want = (want > r->left) ? (size_t)r->left : want;
+        ssize_t got = read(r->fd, r->buf + r->end, want);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got <= 0)
+            return VEC_IO_ERR;  // error or truncated stream
+        r->end += (size_t)got;
+        r->left -= (uint64_t)got;
+    }
+    return VEC_GOOD;
+}
+
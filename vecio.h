@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecio.h
+// Streaming vector serialisation with vectored I/O in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECIO_H
+#define VECIO_H
+#include "vector.h"
+
+// Writes every element of the specified vector to a file descriptor. The 
+// stream starts with the element count and the total payload size, then 
+// holds each element prefixed by its length. Integers are little-endian. 
+// Elements are gathered with writev in batches, so a message takes a handful 
+// of system calls instead of one per element. 
+//
+// PARAMS: 
+// v    - the vector to write
+// fd   - the file descriptor to write to
+// size - returns the size in bytes of an element, receives the context
+// ctx  - the context passed to the size function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_write_fd(const vec_t *v, int fd, 
+        size_t (*size)(const void *, void *), void *ctx);
+
+// Initialises the specified vector from a stream written by vec_write_fd. 
+// The vector is an arena vector whose element copies are carved from a 
+// single slab sized from the stream header, when the header asks for at most 
+// 16 MiB. Larger messages grow the vector and the arena as the payload 
+// arrives, so a bad header cannot force large allocations. Nothing past the 
+// end of the message is read, so messages may follow each other on the same 
+// file descriptor. 
+//
+// PARAMS: 
+// v  - the vector to initialise
+// fd - the file descriptor to read from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_read_fd(vec_t *v, int fd);
+
+#endif
+
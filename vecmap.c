@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecmap.c
+// Persistent by-value vectors mapped from files in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "vecmap.h"
+#define MAP_MAGIC "VECMAP\r\n"
+#define MAP_ORDER 0x01020304u
+#define MAP_HDR 64          // payload offset, keeps elements cache aligned
+#define MAP_TMP ".tmp"      // suffix of the file written before the rename
+
+// The file header, padded with zeros to MAP_HDR bytes. 
+typedef struct vec_map_hdr_t {
+    char magic[8];          // MAP_MAGIC
+    uint32_t version;       // VEC_MAP_VERSION
+    uint32_t order;         // MAP_ORDER in the byte order of the writer
+    uint64_t size;          // size of each element
+    uint64_t len;           // number of elements
+} vec_map_hdr_t;
+
+static void *vec_map_alloc(void *ctx, size_t n);
+static void *vec_map_resize(void *ctx, void *p, size_t n);
+static void vec_map_release(void *ctx, void *p);
+
+// Allocator of mapped vectors, only ever asked to release the mapping. 
+static const vec_alloc_t vec_map = {
+    vec_map_alloc, vec_map_resize, vec_map_release, NULL
+};
+
+// Saves the specified by-value vector to a file. The file holds a 64 byte 
+// header with the element size, the length and the format version, followed 
+// by the elements exactly as they are laid out in memory. Elements are 
+// written in the native byte order and must not contain pointers. The file 
+// is written next to path with a .tmp suffix and renamed over it, so vectors 
+// still mapped from the old file keep reading the old contents. 
+//
+// PARAMS: 
+// v    - the vector to save
+// path - the file to write, replaced if it exists
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_save_sized(const vec_sized_t *v, const char *path) {
+    if (v == NULL || v->data == NULL || path == NULL)
+        return VEC_NULL_ERR;
+
+    unsigned char buf[MAP_HDR] = { 0 };
+    vec_map_hdr_t hdr;
+    memcpy(hdr.magic, MAP_MAGIC, sizeof(hdr.magic));
+    hdr.version = VEC_MAP_VERSION;
+    hdr.order = MAP_ORDER;
+    hdr.size = v->size;
+    hdr.len = v->len;
+    memcpy(buf, &hdr, sizeof(hdr));
+
+    // write a new inode and rename it over, so live mappings keep the old one
+    size_t n = strlen(path);
+    char *tmp = malloc(n + sizeof(MAP_TMP));
+    if (tmp == NULL)
+        return VEC_ALLOC_ERR;
+    memcpy(tmp, path, n);
+    memcpy(tmp + n, MAP_TMP, sizeof(MAP_TMP));
+
+    FILE *f = fopen(tmp, "wb");
+    if (f == NULL) {
+        free(tmp);
+        return VEC_IO_ERR;
+    }
+
+    int ret = VEC_GOOD;
+    if (fwrite(buf, 1, MAP_HDR, f) != MAP_HDR)
+        ret = VEC_IO_ERR;
+    else if (v->len != 0 && fwrite(v->data, v->size, v->len, f) != v->len)
+        ret = VEC_IO_ERR;
+    else if (fflush(f) != 0 || fsync(fileno(f)) != 0)
+        ret = VEC_IO_ERR;
+    if (fclose(f) != 0)
+        ret = VEC_IO_ERR;
+    if (ret == VEC_GOOD && rename(tmp, path) != 0)
+        ret = VEC_IO_ERR;
+    if (ret != VEC_GOOD)
+        remove(tmp);
+    free(tmp);
+    return ret;
+}
+
+// Initialises the specified by-value vector from a file written by 
+// vec_save_sized without copying. The file is mapped read-only and pages are 
+// faulted in on first access. Mutating calls on the vector fail with 
+// VEC_RDONLY_ERR, copy the elements into a new vector to modify them. The 
+// mapping is released by vec_free_sized. 
+//
+// PARAMS: 
+// v    - the vector to initialise
+// path - the file to map
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_mmap_sized(vec_sized_t *v, const char *path) {
+    if (v == NULL || path == NULL)
+        return VEC_NULL_ERR;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return VEC_IO_ERR;
+
+    struct stat st;
+    unsigned char *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size >= MAP_HDR)
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);      // the mapping keeps the file alive
+    if (base == MAP_FAILED)
+        return VEC_IO_ERR;
+
+    // the payload must be exactly len elements, anything else is corrupt
+    vec_map_hdr_t hdr;
+    memcpy(&hdr, base, sizeof(hdr));
+    uint64_t body = (uint64_t)st.st_size - MAP_HDR;
+    if (memcmp(hdr.magic, MAP_MAGIC, sizeof(hdr.magic)) != 0 
+            || hdr.version != VEC_MAP_VERSION || hdr.order != MAP_ORDER 
+            || hdr.size == 0 || hdr.len > body / hdr.size 
+            || hdr.len * hdr.size != body) {
+        munmap(base, (size_t)st.st_size);
+        return VEC_IO_ERR;
+    }
+
+    v->data = base + MAP_HDR;
+    v->len = (size_t)hdr.len;
+    v->max = (size_t)hdr.len;
+    v->size = (size_t)hdr.size;
+    v->alloc = &vec_map;
+    v->grow = VEC_GROW_DOUBLE;
+    v->step = 0;
+    v->rdonly = true;
+    v->inl = false;
+#ifdef VEC_STATS
+    memset(&v->stats, 0, sizeof(v->stats));
+#endif
+    return VEC_GOOD;
+}
+
+// Refuses to allocate, mapped vectors never grow. 
+//
+// PARAMS: 
+// ctx - unused
+// n   - unused
+static void *vec_map_alloc(void *ctx, size_t n) {
+    (void)ctx;
+    (void)n;
+    return NULL;
+}
+
+// Refuses to resize, mapped vectors never grow. 
+//
+// PARAMS: 
+// ctx - unused
+// p   - unused
+// n   - unused
+static void *vec_map_resize(void *ctx, void *p, size_t n) {
+    (void)ctx;
+    (void)p;
+    (void)n;
+    return NULL;
+}
+
+// Unmaps the file behind a mapped vector. The mapping size is recovered 
+// from the header in front of the payload. 
+//
+// PARAMS: 
+// ctx - unused
+// p   - the payload of the mapping
+static void vec_map_release(void *ctx, void *p) {
+    (void)ctx;
+    unsigned char *base = (unsigned char *)p - MAP_HDR;
+    vec_map_hdr_t hdr;
+    memcpy(&hdr, base, sizeof(hdr));
+    munmap(base, MAP_HDR + (size_t)(hdr.len * hdr.size));
+}
+
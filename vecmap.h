@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecmap.h
+// Persistent by-value vectors mapped from files in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECMAP_H
+#define VECMAP_H
+#include "vector.h"
+
+#define VEC_MAP_VERSION 1   // current file format version
+
+// Saves the specified by-value vector to a file. The file holds a 64 byte 
+// header with the element size, the length and the format version, followed 
+// by the elements exactly as they are laid out in memory. Elements are 
+// written in the native byte order and must not contain pointers. The file 
+// is written next to path with a .tmp suffix and renamed over it, so vectors 
+// still mapped from the old file keep reading the old contents. 
+//
+// PARAMS: 
+// v    - the vector to save
+// path - the file to write, replaced if it exists
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_save_sized(const vec_sized_t *v, const char *path);
+
+// Initialises the specified by-value vector from a file written by 
+// vec_save_sized without copying. The file is mapped read-only and pages are 
+// faulted in on first access. Mutating calls on the vector fail with 
+// VEC_RDONLY_ERR, copy the elements into a new vector to modify them. The 
+// mapping is released by vec_free_sized. 
+//
+// PARAMS: 
+// v    - the vector to initialise
+// path - the file to map
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_mmap_sized(vec_sized_t *v, const char *path);
+
+#endif
+
@@ -0,0 +1,446 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecpar.c
+// Parallel vector algorithms in C99 on a shared thread pool. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#include "vecpar.h"
+#define MIN_CHUNK 4096
+#define ISORT_MAX 16
+
+// One chunk of work of a parallel sort. 
+typedef struct par_sort_t {
+    void **src;             // elements to read
+    void **dst;             // elements to write
+    size_t lo;              // start of the first run
+    size_t mid;             // start of the second run
+    size_t hi;              // end of the second run
+    size_t beg;             // start of the merged output written, from lo
+    size_t end;             // end of the merged output written, from lo
+    _Bool stable;           // whether the chunk sort must be stable
+    int (*cmp)(const void *, const void *);     // comparison function
+} par_sort_t;
+
+// Shared state of a parallel foreach. 
+typedef struct par_each_t {
+    const vec_t *v;         // the vector to walk
+    void (*fn)(void *, void *);     // the function to call
+    void *ctx;              // the context of the function
+    size_t next;            // next index to claim
+    size_t grain;           // elements per claim
+} par_each_t;
+
+// One range of a parallel reduce. 
+typedef struct par_reduce_t {
+    const vec_t *v;         // the vector to reduce
+    void *part;             // the partial result
+    size_t lo;              // start of the range
+    size_t hi;              // end of the range
+    void (*fold)(void *, const void *, void *);     // the fold function
+    void *ctx;              // the context of the fold function
+} par_reduce_t;
+
+static int par_sort(vec_t *v, int (*cmp)(const void *, const void *), 
+        vec_pool_t *pool, _Bool stable);
+static void par_run(vec_pool_t *pool, void (*fn)(void *), void *tasks, 
+        size_t stride, size_t n);
+static void par_sort_chunk(void *arg);
+static void par_merge_runs(void *arg);
+static void par_each(void *arg);
+static void par_fold(void *arg);
+static void par_msort(void **a, void **tmp, size_t n, 
+        int (*cmp)(const void *, const void *));
+static void par_merge(void **dst, void **a, size_t na, void **b, size_t nb, 
+        int (*cmp)(const void *, const void *));
+static size_t par_corank(size_t d, void **a, size_t na, void **b, size_t nb, 
+        int (*cmp)(const void *, const void *));
+
+// Sorts the specified vector on the thread pool using the comparison 
+// function. The workers and the caller sort one chunk each, the chunks are 
+// then merged in rounds with every merge split across the threads, so no 
+// round runs on one thread. The comparison function is the same as for 
+// vec_sort. 
+//
+// PARAMS: 
+// v    - the vector to sort
+// cmp  - the comparison function
+// pool - the thread pool, NULL to run on the caller only
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_parallel(vec_t *v, int (*cmp)(const void *, const void *), 
+        vec_pool_t *pool) {
+    return par_sort(v, cmp, pool, false);
+}
+
+// Sorts the specified vector on the thread pool using the comparison 
+// function. Equal elements keep their relative order. 
+//
+// PARAMS: 
+// v    - the vector to sort
+// cmp  - the comparison function
+// pool - the thread pool, NULL to run on the caller only
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_parallel_stable(vec_t *v, int (*cmp)(const void *, const void *), 
+        vec_pool_t *pool) {
+    return par_sort(v, cmp, pool, true);
+}
+
+// Calls the function on every element of the vector on the thread pool. The 
+// workers and the caller claim chunks of grain elements until none are left, 
+// so the function must be safe to call concurrently. 
+//
+// PARAMS: 
+// v     - the vector to walk
+// fn    - the function, receives an element and the context
+// ctx   - the context passed to the function
+// pool  - the thread pool, NULL to run on the caller only
+// grain - the number of elements per chunk, zero to pick one
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_par_foreach(const vec_t *v, void (*fn)(void *, void *), void *ctx, 
+        vec_pool_t *pool, size_t grain) {
+    if (v == NULL || v->data == NULL || fn == NULL)
+        return VEC_NULL_ERR;
+
+    size_t nthreads = vec_pool_size(pool) + 1;
+    if (grain == 0)     // about eight claims per thread
+        grain = v->len / (8 * nthreads) + 1;
+    if (nthreads > v->len / grain + 1)
+        nthreads = v->len / grain + 1;
+
+    par_each_t each = { v, fn, ctx, 0, grain };
+    par_run(pool, par_each, &each, 0, nthreads);
+    return VEC_GOOD;
+}
+
+// Reduces every element of the vector into acc on the thread pool. Every 
+// thread folds a contiguous range of at least grain elements into its own 
+// partial, which starts as a copy of acc. The partials are then combined 
+// into acc in index order, so acc must hold the identity on entry and 
+// combine must be associative. 
+//
+// PARAMS: 
+// v       - the vector to reduce
+// acc     - the accumulator, holds the identity on entry
+// size    - the size of the accumulator
+// fold    - folds an element into a partial, receives the partial, the 
+//           element and the context
+// combine - combines a partial into acc, receives acc, the partial and the 
+//           context
+// ctx     - the context passed to fold and combine
+// pool    - the thread pool, NULL to run on the caller only
+// grain   - the minimum number of elements per thread, zero for one
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_par_reduce(const vec_t *v, void *acc, size_t size, 
+        void (*fold)(void *, const void *, void *), 
+        void (*combine)(void *, const void *, void *), void *ctx, 
+        vec_pool_t *pool, size_t grain) {
+    if (v == NULL || v->data == NULL || acc == NULL || fold == NULL || 
+            combine == NULL)
+        return VEC_NULL_ERR;
+    if (size == 0)
+        return VEC_RANGE_ERR;
+
+    size_t len = v->len;
+    size_t n = vec_pool_size(pool) + 1;
+    grain = (grain == 0) ? 1 : grain;
+    if (n > len / grain)
+        n = (len / grain == 0) ? 1 : len / grain;
+
+    par_reduce_t *tasks = malloc(n * sizeof *tasks);
+    unsigned char *parts = malloc(n * size);
+    if (tasks == NULL || parts == NULL) {
+        free(tasks);
+        free(parts);
+        return VEC_ALLOC_ERR;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        memcpy(parts + i * size, acc, size);
+        tasks[i].v = v;
+        tasks[i].part = parts + i * size;
+        tasks[i].lo = len / n * i + ((i < len % n) ? i : len % n);
+        tasks[i].hi = len / n * (i + 1) + ((i + 1 < len % n) ? i + 1 : len % n);
+        tasks[i].fold = fold;
+        tasks[i].ctx = ctx;
+    }
+    par_run(pool, par_fold, tasks, sizeof *tasks, n);
+
+    for (size_t i = 0; i < n; i++)
+        combine(acc, parts + i * size, ctx);
+    free(parts);
+    free(tasks);
+    return VEC_GOOD;
+}
+
+// Sorts the vector by sorting one chunk per thread, then merging pairs of 
+// adjacent runs in rounds until one run is left. Every merge is split by 
+// co-rank into parts of the output, so all threads share each round, the 
+// last one included. 
+//
+// PARAMS: 
+// v      - the vector to sort
+// cmp    - the comparison function
+// pool   - the thread pool, NULL to run on the caller only
+// stable - whether equal elements must keep their order
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int par_sort(vec_t *v, int (*cmp)(const void *, const void *), 
+        vec_pool_t *pool, _Bool stable) {
+    if (v == NULL || v->data == NULL || cmp == NULL)
+        return VEC_NULL_ERR;
+    vec_compact(v);
+    if (v->len < 2)
+        return VEC_GOOD;
+
+    size_t len = v->len;
+    size_t chunks = vec_pool_size(pool) + 1;   // the caller runs one too
+    if (chunks > len / MIN_CHUNK)
+        chunks = (len / MIN_CHUNK == 0) ? 1 : len / MIN_CHUNK;
+
+    void **tmp = v->alloc->alloc(v->alloc->ctx, len * sizeof(void *));
+    par_sort_t *tasks = malloc(2 * chunks * sizeof *tasks);
+    if (tmp == NULL || tasks == NULL) {
+        if (tmp != NULL)
+            v->alloc->release(v->alloc->ctx, tmp);
+        free(tasks);
+        return VEC_ALLOC_ERR;
+    }
+
+    // run i covers [runs[i], runs[i + 1])
+    size_t *runs = malloc((chunks + 1) * sizeof *runs);
+    if (runs == NULL) {
+        v->alloc->release(v->alloc->ctx, tmp);
+        free(tasks);
+        return VEC_ALLOC_ERR;
+    }
+
+    for (size_t i = 0; i <= chunks; i++)
+        runs[i] = len / chunks * i + ((i < len % chunks) ? i : len % chunks);
+    for (size_t i = 0; i < chunks; i++) {
+        tasks[i].src = v->data;
+        tasks[i].dst = tmp;
+        tasks[i].lo = runs[i];
+        tasks[i].mid = runs[i + 1];
+        tasks[i].hi = runs[i + 1];
+        tasks[i].stable = stable;
+        tasks[i].cmp = cmp;
+    }
+    par_run(pool, par_sort_chunk, tasks, sizeof *tasks, chunks);
+
+    // merge rounds, ping-ponging between the data and tmp buffers
+    void **src = v->data, **dst = tmp;
+    for (size_t nruns = chunks; nruns > 1; nruns = (nruns + 1) / 2) {
+        size_t pairs = (nruns + 1) / 2, n = 0;
+        for (size_t i = 0; i < nruns; i += 2) {
+            size_t lo = runs[i];
+            size_t mid = (i + 1 < nruns) ? runs[i + 1] : runs[nruns];
+            size_t hi = (i + 2 < nruns) ? runs[i + 2] : runs[nruns];
+
+            // at most 2 * chunks parts over every pair of the round
+            size_t m = hi - lo, parts = (chunks + pairs - 1) / pairs;
+            if (parts > m / MIN_CHUNK)
+                parts = (m / MIN_CHUNK == 0) ? 1 : m / MIN_CHUNK;
+            for (size_t p = 0; p < parts; p++, n++) {
+                tasks[n].src = src;
+                tasks[n].dst = dst;
+                tasks[n].lo = lo;
+                tasks[n].mid = mid;
+                tasks[n].hi = hi;
+                tasks[n].beg = m / parts * p 
+                        + ((p < m % parts) ? p : m % parts);
+                tasks[n].end = m / parts * (p + 1) 
+                        + ((p + 1 < m % parts) ? p + 1 : m % parts);
+                tasks[n].cmp = cmp;
+            }
+            runs[i / 2] = lo;
+        }
+        runs[pairs] = runs[nruns];
+        par_run(pool, par_merge_runs, tasks, sizeof *tasks, n);
+
+        void **swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != v->data)
+        memcpy(v->data, src, len * sizeof(void *));
+    v->alloc->release(v->alloc->ctx, tmp);
+    free(runs);
+    free(tasks);
+    return VEC_GOOD;
+}
+
+// Runs every task on the thread pool and waits for all of them. Without a 
+// pool, or if the pool fails to take them, the tasks run on the caller. 
+//
+// PARAMS: 
+// pool   - the thread pool, can be NULL
+// fn     - the function to run
+// tasks  - the tasks to run
+// stride - the size of each task, zero to pass the same task to every run
+// n      - the number of tasks
+static void par_run(vec_pool_t *pool, void (*fn)(void *), void *tasks, 
+        size_t stride, size_t n) {
+    if (pool != NULL && vec_pool_run(pool, fn, tasks, stride, n) == VEC_GOOD)
+        return;
+
+    unsigned char *t = tasks;
+    for (size_t i = 0; i < n; i++)
+        fn(t + i * stride);
+}
+
+// Sorts one chunk of the vector in place. 
+//
+// PARAMS: 
+// arg - the chunk to sort
+static void par_sort_chunk(void *arg) {
+    par_sort_t *t = arg;
+    void **a = t->src + t->lo;
+    size_t n = t->hi - t->lo;
+    if (t->stable)
+        par_msort(a, t->dst + t->lo, n, t->cmp);
+    else
+        qsort(a, n, sizeof(void *), t->cmp);
+}
+
+// Merges one part of two adjacent runs from the source buffer into the 
+// destination, the part of the output from beg to end. 
+//
+// PARAMS: 
+// arg - the runs and the part to merge
+static void par_merge_runs(void *arg) {
+    par_sort_t *t = arg;
+    void **a = t->src + t->lo, **b = t->src + t->mid;
+    size_t na = t->mid - t->lo, nb = t->hi - t->mid;
+    size_t i = par_corank(t->beg, a, na, b, nb, t->cmp);
+    size_t k = par_corank(t->end, a, na, b, nb, t->cmp);
+    size_t j = t->beg - i, l = t->end - k;
+    par_merge(t->dst + t->lo + t->beg, a + i, k - i, b + j, l - j, t->cmp);
+}
+
+// Claims chunks of a parallel foreach until none are left. 
+//
+// PARAMS: 
+// arg - the shared foreach state
+static void par_each(void *arg) {
+    par_each_t *e = arg;
+    size_t len = e->v->len;
+    for (;;) {
+        size_t lo = __atomic_fetch_add(&e->next, e->grain, __ATOMIC_RELAXED);
+        if (lo >= len)
+            break;
+
+        size_t hi = (e->grain > len - lo) ? len : lo + e->grain;
+        for (size_t i = lo; i < hi; i++) {
+            if (hi - i > VEC_PREFETCH_DIST)
+                VEC_PREFETCH(e->v->data[i + VEC_PREFETCH_DIST]);
+            if (e->v->data[i] != NULL)
+                e->fn(e->v->data[i], e->ctx);
+        }
+    }
+}
+
+// Folds one range of a parallel reduce into its partial. 
+//
+// PARAMS: 
+// arg - the range to fold
+static void par_fold(void *arg) {
+    par_reduce_t *t = arg;
+    for (size_t i = t->lo; i < t->hi; i++) {
+        if (t->hi - i > VEC_PREFETCH_DIST)
+            VEC_PREFETCH(t->v->data[i + VEC_PREFETCH_DIST]);
+        if (t->v->data[i] != NULL)
+            t->fold(t->part, t->v->data[i], t->ctx);
+    }
+}
+
+// Stable merge sort of n elements using tmp as scratch space. 
+//
+// PARAMS: 
+// a   - the elements to sort
+// tmp - scratch space for n elements
+// n   - the number of elements
+// cmp - the comparison function
+static void par_msort(void **a, void **tmp, size_t n, 
+        int (*cmp)(const void *, const void *)) {
+    if (n <= ISORT_MAX) {
+        for (size_t i = 1; i < n; i++) {
+            void *x = a[i];
+            size_t j = i;
+            for (; j > 0 && cmp(&x, &a[j - 1]) < 0; j--)
+                a[j] = a[j - 1];
+            a[j] = x;
+        }
+        return;
+    }
+
+    size_t h = n / 2;
+    par_msort(a, tmp, h, cmp);
+    par_msort(a + h, tmp, n - h, cmp);
+    if (cmp(&a[h], &a[h - 1]) >= 0)
+        return;     // already in order
+    par_merge(tmp, a, h, a + h, n - h, cmp);
+    memcpy(a, tmp, n * sizeof(void *));
+}
+
+// Finds how many elements of the first run are among the first d elements 
+// of the stable merge of the two runs, by binary search. 
+//
+// PARAMS: 
+// d   - the number of merged elements, at most na + nb
+// a   - the first run
+// na  - the length of the first run
+// b   - the second run
+// nb  - the length of the second run
+// cmp - the comparison function
+//
+// RET: 
+// The number of elements taken from the first run. 
+static size_t par_corank(size_t d, void **a, size_t na, void **b, size_t nb, 
+        int (*cmp)(const void *, const void *)) {
+    size_t lo = (d > nb) ? d - nb : 0, hi = (d < na) ? d : na;
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        if (cmp(&b[d - i - 1], &a[i]) < 0)
+            hi = i;     // b[d - i - 1] comes before a[i]
+        else
+            lo = i + 1;
+    }
+    return lo;
+}
+
+// Stable merge of two sorted runs into dst. 
+//
+// PARAMS: 
+// dst - where to write the merged elements
+// a   - the first run
+// na  - the length of the first run
+// b   - the second run
+// nb  - the length of the second run
+// cmp - the comparison function
+static void par_merge(void **dst, void **a, size_t na, void **b, size_t nb, 
+        int (*cmp)(const void *, const void *)) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        if (na - i > VEC_PREFETCH_DIST)
+            VEC_PREFETCH(a[i + VEC_PREFETCH_DIST]);
+        if (nb - j > VEC_PREFETCH_DIST)
+            VEC_PREFETCH(b[j + VEC_PREFETCH_DIST]);
+        dst[k++] = (cmp(&b[j], &a[i]) < 0) ? b[j++] : a[i++];
+    }
+    if (i < na)
+        memcpy(dst + k, a + i, (na - i) * sizeof(void *));
+    if (j < nb)
+        memcpy(dst + k, b + j, (nb - j) * sizeof(void *));
+}
+
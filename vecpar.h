@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecpar.h
+// Parallel vector algorithms in C99 on a shared thread pool. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECPAR_H
+#define VECPAR_H
+#include "vector.h"
+#include "vecpool.h"
+
+// Sorts the specified vector on the thread pool using the comparison 
+// function. The workers and the caller sort one chunk each, the chunks are 
+// then merged in rounds with every merge split across the threads, so no 
+// round runs on one thread. The comparison function is the same as for 
+// vec_sort. 
+//
+// PARAMS: 
+// v    - the vector to sort
+// cmp  - the comparison function
+// pool - the thread pool, NULL to run on the caller only
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_parallel(vec_t *v, int (*cmp)(const void *, const void *), 
+        vec_pool_t *pool);
+
+// Sorts the specified vector on the thread pool using the comparison 
+// function. Equal elements keep their relative order. 
+//
+// PARAMS: 
+// v    - the vector to sort
+// cmp  - the comparison function
+// pool - the thread pool, NULL to run on the caller only
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_parallel_stable(vec_t *v, int (*cmp)(const void *, const void *), 
+        vec_pool_t *pool);
+
+// Calls the function on every element of the vector on the thread pool. The 
+// workers and the caller claim chunks of grain elements until none are left, 
+// so the function must be safe to call concurrently. 
+//
+// PARAMS: 
+// v     - the vector to walk
+// fn    - the function, receives an element and the context
+// ctx   - the context passed to the function
+// pool  - the thread pool, NULL to run on the caller only
+// grain - the number of elements per chunk, zero to pick one
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_par_foreach(const vec_t *v, void (*fn)(void *, void *), void *ctx, 
+        vec_pool_t *pool, size_t grain);
+
+// Reduces every element of the vector into acc on the thread pool. Every 
+// thread folds a contiguous range of at least grain elements into its own 
+// partial, which starts as a copy of acc. The partials are then combined 
+// into acc in index order, so acc must hold the identity on entry and 
+// combine must be associative. 
+//
+// PARAMS: 
+// v       - the vector to reduce
+// acc     - the accumulator, holds the identity on entry
+// size    - the size of the accumulator
+// fold    - folds an element into a partial, receives the partial, the 
+//           element and the context
+// combine - combines a partial into acc, receives acc, the partial and the 
+//           context
+// ctx     - the context passed to fold and combine
+// pool    - the thread pool, NULL to run on the caller only
+// grain   - the minimum number of elements per thread, zero for one
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_par_reduce(const vec_t *v, void *acc, size_t size, 
+        void (*fold)(void *, const void *, void *), 
+        void (*combine)(void *, const void *, void *), void *ctx, 
+        vec_pool_t *pool, size_t grain);
+
+#endif
+
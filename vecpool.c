@@ -0,0 +1,413 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecpool.c
+// Work-stealing thread pool for the parallel vector algorithms in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include "vecpool.h"
+#define DEF_MAX 64
+
+// Tasks started by one vec_pool_run call. 
+typedef struct pool_group_t {
+    size_t left;            // number of tasks not finished
+    pthread_mutex_t lock;   // guards the wakeup
+    pthread_cond_t done;    // signalled when left drops to zero
+} pool_group_t;
+
+// A queued task. 
+typedef struct pool_task_t {
+    void (*fn)(void *);     // the task function
+    void *arg;              // the task argument
+    pool_group_t *group;    // the group to notify, NULL if none
+} pool_task_t;
+
+// The deque of one worker, a circular buffer of tasks. 
+typedef struct pool_deque_t {
+    pool_task_t *data;      // internal data
+    size_t head;            // index of the front task
+    size_t len;             // current length
+    size_t max;             // maximum length, always a power of two
+    pthread_mutex_t lock;   // guards the deque
+} pool_deque_t;
+
+// One worker of the thread pool. 
+typedef struct pool_worker_t {
+    vec_pool_t *pool;       // the owning pool
+    size_t id;              // the index of the worker and its deque
+    pthread_t thread;       // the worker thread
+} pool_worker_t;
+
+// The thread pool. 
+struct vec_pool_t {
+    size_t n;               // number of workers
+    pool_worker_t *workers; // the workers
+    pool_deque_t *deques;   // one deque per worker
+    size_t next;            // round-robin counter for queueing
+    size_t victim;          // round-robin counter for outside helpers
+    size_t queued;          // number of queued tasks
+    _Bool stop;             // whether the workers should exit
+    pthread_mutex_t lock;   // guards sleeping and stopping
+    pthread_cond_t wake;    // signalled when tasks are queued
+};
+
+static void *pool_main(void *arg);
+static int pool_push(vec_pool_t *p, const pool_task_t *t);
+static size_t pool_self(vec_pool_t *p);
+static _Bool pool_take(vec_pool_t *p, size_t self, pool_task_t *t);
+static void pool_exec(const pool_task_t *t);
+static _Bool deq_push(pool_deque_t *d, const pool_task_t *t);
+static _Bool deq_pop_back(pool_deque_t *d, pool_task_t *t);
+static _Bool deq_pop_front(pool_deque_t *d, pool_task_t *t);
+
+// Creates a thread pool with n workers. 
+//
+// PARAMS: 
+// n - the number of workers, at least one
+//
+// RET: 
+// The thread pool, or NULL on error. 
+vec_pool_t *vec_pool_create(size_t n) {
+    if (n == 0)
+        return NULL;
+
+    vec_pool_t *p = malloc(sizeof *p);
+    if (p == NULL)
+        return NULL;
+    p->workers = calloc(n, sizeof *p->workers);
+    p->deques = calloc(n, sizeof *p->deques);
+    if (p->workers == NULL || p->deques == NULL) {
+        free(p->workers);
+        free(p->deques);
+        free(p);
+        return NULL;
+    }
+
+    p->n = n;
+    p->next = 0;
+    p->victim = 0;
+    p->queued = 0;
+    p->stop = false;
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->wake, NULL);
+    _Bool ok = true;
+    for (size_t i = 0; i < n; i++) {
+        pthread_mutex_init(&p->deques[i].lock, NULL);
+        p->deques[i].data = malloc(DEF_MAX * sizeof(pool_task_t));
+        p->deques[i].max = DEF_MAX;
+        ok = ok && (p->deques[i].data != NULL);
+    }
+
+    size_t started = 0;
+    for (; ok && started < n; started++) {
+        p->workers[started].pool = p;
+        p->workers[started].id = started;
+        ok = (pthread_create(&p->workers[started].thread, NULL, pool_main, 
+                &p->workers[started]) == 0);
+        if (!ok)
+            p->workers[started].pool = NULL;
+    }
+
+    if (!ok) {      // vec_pool_destroy only joins the workers that started
+        vec_pool_destroy(p);
+        return NULL;
+    }
+    return p;
+}
+
+// Returns the number of workers in the thread pool. 
+//
+// PARAMS: 
+// p - the thread pool
+//
+// RET: 
+// The number of workers, zero if p is NULL. 
+size_t vec_pool_size(const vec_pool_t *p) {
+    return (p == NULL) ? 0 : p->n;
+}
+
+// Queues a task on the thread pool without waiting for it. 
+//
+// PARAMS: 
+// p   - the thread pool
+// fn  - the task function
+// arg - the argument passed to the task function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_pool_submit(vec_pool_t *p, void (*fn)(void *), void *arg) {
+    if (p == NULL || fn == NULL)
+        return VEC_NULL_ERR;
+
+    pool_task_t t = { fn, arg, NULL };
+    return pool_push(p, &t);
+}
+
+// Runs n tasks on the thread pool and waits for all of them. The caller 
+// runs queued tasks while it waits, so tasks may call this function again. 
+// A worker caller takes from its own deque first, any other caller steals 
+// from the front of the deques in turn. 
+//
+// PARAMS: 
+// p      - the thread pool
+// fn     - the task function
+// tasks  - the task arguments
+// stride - the size of each argument, zero to pass tasks to every run
+// n      - the number of tasks
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_pool_run(vec_pool_t *p, void (*fn)(void *), void *tasks, 
+        size_t stride, size_t n) {
+    if (p == NULL || fn == NULL)
+        return VEC_NULL_ERR;
+    if (n == 0)
+        return VEC_GOOD;
+
+    pool_group_t g;
+    g.left = n;
+    pthread_mutex_init(&g.lock, NULL);
+    pthread_cond_init(&g.done, NULL);
+
+    // the first task runs on the caller, any task that fails to queue too
+    unsigned char *arg = tasks;
+    for (size_t i = 1; i < n; i++) {
+        pool_task_t t = { fn, arg + i * stride, &g };
+        if (pool_push(p, &t) != VEC_GOOD)
+            pool_exec(&t);
+    }
+    pool_task_t first = { fn, arg, &g };
+    pool_exec(&first);
+
+    // help with queued tasks until the group is finished
+    size_t self = pool_self(p);
+    pool_task_t t;
+    while (__atomic_load_n(&g.left, __ATOMIC_ACQUIRE) != 0) {
+        if (pool_take(p, self, &t)) {
+            pool_exec(&t);
+            continue;
+        }
+
+        pthread_mutex_lock(&g.lock);
+        while (__atomic_load_n(&g.left, __ATOMIC_ACQUIRE) != 0)
+            pthread_cond_wait(&g.done, &g.lock);
+        pthread_mutex_unlock(&g.lock);
+    }
+
+    // the last task finishes under the lock, wait for it to let go
+    pthread_mutex_lock(&g.lock);
+    pthread_mutex_unlock(&g.lock);
+    pthread_mutex_destroy(&g.lock);
+    pthread_cond_destroy(&g.done);
+    return VEC_GOOD;
+}
+
+// Destroys the thread pool after running every queued task. 
+//
+// PARAMS: 
+// p - the thread pool to destroy
+void vec_pool_destroy(vec_pool_t *p) {
+    if (p == NULL)
+        return;
+
+    pthread_mutex_lock(&p->lock);
+    p->stop = true;
+    pthread_cond_broadcast(&p->wake);
+    pthread_mutex_unlock(&p->lock);
+
+    for (size_t i = 0; i < p->n; i++) {
+        if (p->workers[i].pool != NULL)
+            pthread_join(p->workers[i].thread, NULL);
+    }
+    for (size_t i = 0; i < p->n; i++) {
+        free(p->deques[i].data);
+        pthread_mutex_destroy(&p->deques[i].lock);
+    }
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->wake);
+    free(p->workers);
+    free(p->deques);
+    free(p);
+}
+
+// Main loop of a worker, runs tasks until the pool stops and drains. 
+//
+// PARAMS: 
+// arg - the worker
+static void *pool_main(void *arg) {
+    pool_worker_t *w = arg;
+    vec_pool_t *p = w->pool;
+    pool_task_t t;
+    for (;;) {
+        if (pool_take(p, w->id, &t)) {
+            pool_exec(&t);
+            continue;
+        }
+
+        pthread_mutex_lock(&p->lock);
+        while (__atomic_load_n(&p->queued, __ATOMIC_ACQUIRE) == 0 && !p->stop)
+            pthread_cond_wait(&p->wake, &p->lock);
+        _Bool done = p->stop && 
+            __atomic_load_n(&p->queued, __ATOMIC_ACQUIRE) == 0;
+        pthread_mutex_unlock(&p->lock);
+        if (done)
+            break;
+    }
+    return NULL;
+}
+
+// Queues a task on the next deque in round-robin order and wakes a worker. 
+//
+// PARAMS: 
+// p - the thread pool
+// t - the task to queue
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int pool_push(vec_pool_t *p, const pool_task_t *t) {
+    size_t i = __atomic_fetch_add(&p->next, 1, __ATOMIC_RELAXED) % p->n;
+
+    // count first, so a racing thief never drops queued below zero
+    pthread_mutex_lock(&p->lock);
+    __atomic_fetch_add(&p->queued, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&p->lock);
+    if (!deq_push(&p->deques[i], t)) {
+        __atomic_fetch_sub(&p->queued, 1, __ATOMIC_RELEASE);
+        return VEC_ALLOC_ERR;
+    }
+
+    pthread_mutex_lock(&p->lock);
+    pthread_cond_signal(&p->wake);
+    pthread_mutex_unlock(&p->lock);
+    return VEC_GOOD;
+}
+
+// Finds the worker running on the calling thread. 
+//
+// PARAMS: 
+// p - the thread pool
+//
+// RET: 
+// The index of the worker, or the number of workers if the caller is not 
+// one of them. 
+static size_t pool_self(vec_pool_t *p) {
+    pthread_t me = pthread_self();
+    for (size_t i = 0; i < p->n; i++)
+        if (p->workers[i].pool != NULL && 
+                pthread_equal(p->workers[i].thread, me))
+            return i;
+    return p->n;
+}
+
+// Takes a task, from the back of the own deque first, then from the front of 
+// the other deques. A caller without a deque only steals, starting from the 
+// next deque in round-robin order so outside helpers spread over the workers. 
+//
+// PARAMS: 
+// p    - the thread pool
+// self - the index of the own deque, the number of workers if none
+// t    - where to store the task
+//
+// RET: 
+// True if a task was taken, false if every deque is empty. 
+static _Bool pool_take(vec_pool_t *p, size_t self, pool_task_t *t) {
+    _Bool own = (self < p->n);
+    _Bool ret = own && deq_pop_back(&p->deques[self], t);
+    size_t from = own ? self + 1 
+            : __atomic_fetch_add(&p->victim, 1, __ATOMIC_RELAXED);
+    for (size_t i = 0; i < p->n - own && !ret; i++)
+        ret = deq_pop_front(&p->deques[(from + i) % p->n], t);
+    if (ret)
+        __atomic_fetch_sub(&p->queued, 1, __ATOMIC_RELEASE);
+    return ret;
+}
+
+// Runs a task and notifies its group. 
+//
+// PARAMS: 
+// t - the task to run
+static void pool_exec(const pool_task_t *t) {
+    t->fn(t->arg);
+    pool_group_t *g = t->group;
+    if (g != NULL) {
+        pthread_mutex_lock(&g->lock);
+        if (__atomic_sub_fetch(&g->left, 1, __ATOMIC_ACQ_REL) == 0)
+            pthread_cond_broadcast(&g->done);
+        pthread_mutex_unlock(&g->lock);
+    }
+}
+
+// Pushes a task to the back of a deque. 
+//
+// PARAMS: 
+// d - the deque
+// t - the task to push
+//
+// RET: 
+// True on success, false on error. 
+static _Bool deq_push(pool_deque_t *d, const pool_task_t *t) {
+    _Bool ret = true;
+    pthread_mutex_lock(&d->lock);
+    if (d->len == d->max) {
+        pool_task_t *temp = realloc(d->data, 2 * d->max * (sizeof *temp));
+        if (temp == NULL) {
+            ret = false;
+        } else {
+            // full, so [0, head) is the wrapped tail
+            memcpy(temp + d->max, temp, d->head * sizeof *temp);
+            d->data = temp;
+            d->max *= 2;
+        }
+    }
+    if (ret) {
+        d->data[(d->head + d->len) & (d->max - 1)] = *t;
+        d->len++;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ret;
+}
+
+// Pops a task from the back of a deque. 
+//
+// PARAMS: 
+// d - the deque
+// t - where to store the task
+//
+// RET: 
+// True if a task was popped, false if the deque is empty. 
+static _Bool deq_pop_back(pool_deque_t *d, pool_task_t *t) {
+    _Bool ret = false;
+    pthread_mutex_lock(&d->lock);
+    if (d->len != 0) {
+        d->len--;
+        *t = d->data[(d->head + d->len) & (d->max - 1)];
+        ret = true;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ret;
+}
+
+// Pops a task from the front of a deque. 
+//
+// PARAMS: 
+// d - the deque
+// t - where to store the task
+//
+// RET: 
+// True if a task was popped, false if the deque is empty. 
+static _Bool deq_pop_front(pool_deque_t *d, pool_task_t *t) {
+    _Bool ret = false;
+    pthread_mutex_lock(&d->lock);
+    if (d->len != 0) {
+        *t = d->data[d->head];
+        d->head = (d->head + 1) & (d->max - 1);
+        d->len--;
+        ret = true;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ret;
+}
+
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecpool.h
+// Work-stealing thread pool for the parallel vector algorithms in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECPOOL_H
+#define VECPOOL_H
+#include "vector.h"
+
+// The thread pool. Every worker owns a deque of tasks, takes its own tasks 
+// from the back and steals from the front of the others when it runs out. 
+typedef struct vec_pool_t vec_pool_t;
+
+// Creates a thread pool with n workers. 
+//
+// PARAMS: 
+// n - the number of workers, at least one
+//
+// RET: 
+// The thread pool, or NULL on error. 
+vec_pool_t *vec_pool_create(size_t n);
+
+// Returns the number of workers in the thread pool. 
+//
+// PARAMS: 
+// p - the thread pool
+//
+// RET: 
+// The number of workers, zero if p is NULL. 
+size_t vec_pool_size(const vec_pool_t *p);
+
+// Queues a task on the thread pool without waiting for it. 
+//
+// PARAMS: 
+// p   - the thread pool
+// fn  - the task function
+// arg - the argument passed to the task function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_pool_submit(vec_pool_t *p, void (*fn)(void *), void *arg);
+
+// Runs n tasks on the thread pool and waits for all of them. The caller 
+// runs queued tasks while it waits, so tasks may call this function again. 
+// A worker caller takes from its own deque first, any other caller steals 
+// from the front of the deques in turn. 
+//
+// PARAMS: 
+// p      - the thread pool
+// fn     - the task function
+// tasks  - the task arguments
+// stride - the size of each argument, zero to pass tasks to every run
+// n      - the number of tasks
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_pool_run(vec_pool_t *p, void (*fn)(void *), void *tasks, 
+        size_t stride, size_t n);
+
+// Destroys the thread pool after running every queued task. 
+//
+// PARAMS: 
+// p - the thread pool to destroy
+void vec_pool_destroy(vec_pool_t *p);
+
+#endif
+
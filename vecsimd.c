@@ -0,0 +1,430 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecsimd.c
+// SIMD search and compare kernels for by-value vectors in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#include "vecsimd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) \
+    && defined(__SSE2__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#define SIMD_AVX2 __attribute__((target("avx2")))
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define SIMD_BASE           // kernels built for the baseline instruction set
+
+static _Bool simd_check(const vec_sized_t *v, size_t size);
+
+// Scalar kernels, used on their own and for the tails of the SIMD kernels. 
+// The min and max kernels need at least one element. 
+#define SIMD_SCALAR(sfx, T)                                                  \
+static size_t simd_find_##sfx(const T *a, size_t n, T x) {                   \
+    for (size_t i = 0; i < n; i++)                                           \
+        if (a[i] == x)                                                       \
+            return i;                                                        \
+    return n;                                                                \
+}                                                                            \
+                                                                             \
+static size_t simd_count_##sfx(const T *a, size_t n, T x) {                  \
+    size_t c = 0;                                                            \
+    for (size_t i = 0; i < n; i++)                                           \
+        c += (a[i] == x);                                                    \
+    return c;                                                                \
+}                                                                            \
+                                                                             \
+static T simd_min_##sfx(const T *a, size_t n) {                              \
+    T m = a[0];                                                              \
+    for (size_t i = 1; i < n; i++)                                           \
+        if (a[i] < m)                                                        \
+            m = a[i];                                                        \
+    return m;                                                                \
+}                                                                            \
+                                                                             \
+static T simd_max_##sfx(const T *a, size_t n) {                              \
+    T m = a[0];                                                              \
+    for (size_t i = 1; i < n; i++)                                           \
+        if (a[i] > m)                                                        \
+            m = a[i];                                                        \
+    return m;                                                                \
+}
+
+SIMD_SCALAR(i32, int32_t)
+SIMD_SCALAR(i64, int64_t)
+SIMD_SCALAR(f32, float)
+SIMD_SCALAR(f64, double)
+
+// Find and count kernels processing W lanes at a time. The instruction set 
+// isa must provide isa_set_sfx (broadcast), isa_ld_sfx (unaligned load) and 
+// isa_eq_sfx (lane equality as a bit mask, lane 0 in bit 0). 
+#define SIMD_FINDS(sfx, isa, T, V, W, attr)                                  \
+attr static size_t simd_find_##sfx##_##isa(const T *a, size_t n, T x) {      \
+    V k = isa##_set_##sfx(x);                                                \
+    size_t i = 0;                                                            \
+    for (; i + W <= n; i += W) {                                             \
+        unsigned m = isa##_eq_##sfx(isa##_ld_##sfx(a + i), k);               \
+        if (m != 0)                                                          \
+            return i + (size_t)__builtin_ctz(m);                             \
+    }                                                                        \
+    return i + simd_find_##sfx(a + i, n - i, x);                             \
+}                                                                            \
+                                                                             \
+attr static size_t simd_count_##sfx##_##isa(const T *a, size_t n, T x) {     \
+    V k = isa##_set_##sfx(x);                                                \
+    size_t i = 0, c = 0;                                                     \
+    for (; i + W <= n; i += W)                                               \
+        c += __builtin_popcount(isa##_eq_##sfx(isa##_ld_##sfx(a + i), k));   \
+    return c + simd_count_##sfx(a + i, n - i, x);                            \
+}
+
+// Min or max kernel processing W lanes at a time, op is min or max. The 
+// instruction set isa must provide isa_ld_sfx, isa_op_sfx (lane-wise op) and 
+// isa_st_sfx (unaligned store). 
+#define SIMD_REDUCE(op, sfx, isa, T, V, W, attr)                             \
+attr static T simd_##op##_##sfx##_##isa(const T *a, size_t n) {              \
+    if (n < W)                                                               \
+        return simd_##op##_##sfx(a, n);                                      \
+    V r = isa##_ld_##sfx(a);                                                 \
+    size_t i = W;                                                            \
+    for (; i + W <= n; i += W)                                               \
+        r = isa##_##op##_##sfx(r, isa##_ld_##sfx(a + i));                    \
+    T t[W];                                                                  \
+    isa##_st_##sfx(t, r);                                                    \
+    t[0] = simd_##op##_##sfx(t, W);                                          \
+    if (i < n)                                                               \
+        t[1] = simd_##op##_##sfx(a + i, n - i);                              \
+    return simd_##op##_##sfx(t, (i < n) ? 2 : 1);                            \
+}
+
+#define SIMD_ALL(sfx, isa, T, V, W, attr)                                    \
+    SIMD_FINDS(sfx, isa, T, V, W, attr)                                      \
+    SIMD_REDUCE(min, sfx, isa, T, V, W, attr)                                \
+    SIMD_REDUCE(max, sfx, isa, T, V, W, attr)
+
+#if defined(SIMD_X86)
+// SSE2 lanes. SSE2 has no 64-bit integer compare, so i64 min and max stay 
+// scalar. 
+static inline __m128i sse2_cmpeq64(__m128i a, __m128i b) {
+    __m128i c = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(c, _mm_shuffle_epi32(c, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+static inline __m128i sse2_blend(__m128i m, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+}
+
+#define sse2_set_i32(x) _mm_set1_epi32(x)
+#define sse2_ld_i32(p) _mm_loadu_si128((const __m128i *)(p))
+#define sse2_st_i32(p, r) _mm_storeu_si128((__m128i *)(p), r)
+#define sse2_eq_i32(a, b) \
+    (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))
+#define sse2_min_i32(a, b) sse2_blend(_mm_cmpgt_epi32(a, b), b, a)
+#define sse2_max_i32(a, b) sse2_blend(_mm_cmpgt_epi32(a, b), a, b)
+
+#define sse2_set_i64(x) _mm_set1_epi64x(x)
+#define sse2_ld_i64(p) _mm_loadu_si128((const __m128i *)(p))
+#define sse2_eq_i64(a, b) \
+    (unsigned)_mm_movemask_pd(_mm_castsi128_pd(sse2_cmpeq64(a, b)))
+#define simd_min_i64_sse2 simd_min_i64
+#define simd_max_i64_sse2 simd_max_i64
+
+#define sse2_set_f32(x) _mm_set1_ps(x)
+#define sse2_ld_f32(p) _mm_loadu_ps(p)
+#define sse2_st_f32(p, r) _mm_storeu_ps(p, r)
+#define sse2_eq_f32(a, b) (unsigned)_mm_movemask_ps(_mm_cmpeq_ps(a, b))
+#define sse2_min_f32(a, b) _mm_min_ps(a, b)
+#define sse2_max_f32(a, b) _mm_max_ps(a, b)
+
+#define sse2_set_f64(x) _mm_set1_pd(x)
+#define sse2_ld_f64(p) _mm_loadu_pd(p)
+#define sse2_st_f64(p, r) _mm_storeu_pd(p, r)
+#define sse2_eq_f64(a, b) (unsigned)_mm_movemask_pd(_mm_cmpeq_pd(a, b))
+#define sse2_min_f64(a, b) _mm_min_pd(a, b)
+#define sse2_max_f64(a, b) _mm_max_pd(a, b)
+
+SIMD_ALL(i32, sse2, int32_t, __m128i, 4, SIMD_BASE)
+SIMD_FINDS(i64, sse2, int64_t, __m128i, 2, SIMD_BASE)
+SIMD_ALL(f32, sse2, float, __m128, 4, SIMD_BASE)
+SIMD_ALL(f64, sse2, double, __m128d, 2, SIMD_BASE)
+
+// AVX2 lanes, only called once the CPU is known to support them. 
+#define avx2_set_i32(x) _mm256_set1_epi32(x)
+#define avx2_ld_i32(p) _mm256_loadu_si256((const __m256i *)(p))
+#define avx2_st_i32(p, r) _mm256_storeu_si256((__m256i *)(p), r)
+#define avx2_eq_i32(a, b) \
+    (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))
+#define avx2_min_i32(a, b) _mm256_min_epi32(a, b)
+#define avx2_max_i32(a, b) _mm256_max_epi32(a, b)
+
+#define avx2_set_i64(x) _mm256_set1_epi64x(x)
+#define avx2_ld_i64(p) _mm256_loadu_si256((const __m256i *)(p))
+#define avx2_st_i64(p, r) _mm256_storeu_si256((__m256i *)(p), r)
+#define avx2_eq_i64(a, b) \
+    (unsigned)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))
+#define avx2_min_i64(a, b) _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b))
+#define avx2_max_i64(a, b) _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b))
+
+#define avx2_set_f32(x) _mm256_set1_ps(x)
+#define avx2_ld_f32(p) _mm256_loadu_ps(p)
+#define avx2_st_f32(p, r) _mm256_storeu_ps(p, r)
+#define avx2_eq_f32(a, b) \
+    (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))
+#define avx2_min_f32(a, b) _mm256_min_ps(a, b)
+#define avx2_max_f32(a, b) _mm256_max_ps(a, b)
+
+#define avx2_set_f64(x) _mm256_set1_pd(x)
+#define avx2_ld_f64(p) _mm256_loadu_pd(p)
+#define avx2_st_f64(p, r) _mm256_storeu_pd(p, r)
+#define avx2_eq_f64(a, b) \
+    (unsigned)_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))
+#define avx2_min_f64(a, b) _mm256_min_pd(a, b)
+#define avx2_max_f64(a, b) _mm256_max_pd(a, b)
+
+SIMD_ALL(i32, avx2, int32_t, __m256i, 8, SIMD_AVX2)
+SIMD_ALL(i64, avx2, int64_t, __m256i, 4, SIMD_AVX2)
+SIMD_ALL(f32, avx2, float, __m256, 8, SIMD_AVX2)
+SIMD_ALL(f64, avx2, double, __m256d, 4, SIMD_AVX2)
+
+// Checks once whether the CPU supports AVX2. 
+//
+// RET: 
+// True if AVX2 kernels can be used. 
+static _Bool simd_has_avx2(void) {
+    static int has = -1;
+    int h = __atomic_load_n(&has, __ATOMIC_RELAXED);
+    if (h < 0) {
+        __builtin_cpu_init();
+        h = __builtin_cpu_supports("avx2") != 0;
+        __atomic_store_n(&has, h, __ATOMIC_RELAXED);
+    }
+    return h != 0;
+}
+
+#define SIMD_CALL(k, ...) \
+    (simd_has_avx2() ? k##_avx2(__VA_ARGS__) : k##_sse2(__VA_ARGS__))
+#elif defined(SIMD_NEON)
+// NEON lanes. There is no movemask, equality lanes are folded into a bit 
+// mask by keeping one weighted bit per lane and summing across. 
+static inline unsigned neon_mask32(uint32x4_t m) {
+    const uint32_t w[4] = { 1, 2, 4, 8 };
+    return vaddvq_u32(vandq_u32(m, vld1q_u32(w)));
+}
+
+static inline unsigned neon_mask64(uint64x2_t m) {
+    const uint64_t w[2] = { 1, 2 };
+    return (unsigned)vaddvq_u64(vandq_u64(m, vld1q_u64(w)));
+}
+
+#define neon_set_i32(x) vdupq_n_s32(x)
+#define neon_ld_i32(p) vld1q_s32(p)
+#define neon_st_i32(p, r) vst1q_s32(p, r)
+#define neon_eq_i32(a, b) neon_mask32(vceqq_s32(a, b))
+#define neon_min_i32(a, b) vminq_s32(a, b)
+#define neon_max_i32(a, b) vmaxq_s32(a, b)
+
+#define neon_set_i64(x) vdupq_n_s64(x)
+#define neon_ld_i64(p) vld1q_s64(p)
+#define neon_st_i64(p, r) vst1q_s64(p, r)
+#define neon_eq_i64(a, b) neon_mask64(vceqq_s64(a, b))
+#define neon_min_i64(a, b) vbslq_s64(vcgtq_s64(a, b), b, a)
+#define neon_max_i64(a, b) vbslq_s64(vcgtq_s64(a, b), a, b)
+
+#define neon_set_f32(x) vdupq_n_f32(x)
+#define neon_ld_f32(p) vld1q_f32(p)
+#define neon_st_f32(p, r) vst1q_f32(p, r)
+#define neon_eq_f32(a, b) neon_mask32(vceqq_f32(a, b))
+#define neon_min_f32(a, b) vminq_f32(a, b)
+#define neon_max_f32(a, b) vmaxq_f32(a, b)
+
+#define neon_set_f64(x) vdupq_n_f64(x)
+#define neon_ld_f64(p) vld1q_f64(p)
+#define neon_st_f64(p, r) vst1q_f64(p, r)
+#define neon_eq_f64(a, b) neon_mask64(vceqq_f64(a, b))
+#define neon_min_f64(a, b) vminq_f64(a, b)
+#define neon_max_f64(a, b) vmaxq_f64(a, b)
+
+SIMD_ALL(i32, neon, int32_t, int32x4_t, 4, SIMD_BASE)
+SIMD_ALL(i64, neon, int64_t, int64x2_t, 2, SIMD_BASE)
+SIMD_ALL(f32, neon, float, float32x4_t, 4, SIMD_BASE)
+SIMD_ALL(f64, neon, double, float64x2_t, 2, SIMD_BASE)
+
+#define SIMD_CALL(k, ...) k##_neon(__VA_ARGS__)
+#else
+#define SIMD_CALL(k, ...) k(__VA_ARGS__)
+#endif
+
+// Finds the first element equal to x. 
+//
+// PARAMS: 
+// v - the vector to search
+// x - the value to search for
+//
+// RET: 
+// The index of the element, or the length if there is none. A vector that 
+// is NULL, freed or of a different element size is treated as having no 
+// equal element, so the result is its length, or zero if it is NULL. 
+size_t vec_find_i32(const vec_sized_t *v, int32_t x) {
+    if (!simd_check(v, sizeof(x)))
+        return (v == NULL) ? 0 : v->len;
+    return SIMD_CALL(simd_find_i32, (const int32_t *)v->data, v->len, x);
+}
+
+size_t vec_find_i64(const vec_sized_t *v, int64_t x) {
+    if (!simd_check(v, sizeof(x)))
+        return (v == NULL) ? 0 : v->len;
+    return SIMD_CALL(simd_find_i64, (const int64_t *)v->data, v->len, x);
+}
+
+size_t vec_find_f32(const vec_sized_t *v, float x) {
+    if (!simd_check(v, sizeof(x)))
+        return (v == NULL) ? 0 : v->len;
+    return SIMD_CALL(simd_find_f32, (const float *)v->data, v->len, x);
+}
+
+size_t vec_find_f64(const vec_sized_t *v, double x) {
+    if (!simd_check(v, sizeof(x)))
+        return (v == NULL) ? 0 : v->len;
+    return SIMD_CALL(simd_find_f64, (const double *)v->data, v->len, x);
+}
+
+// Counts the elements equal to x. 
+//
+// PARAMS: 
+// v - the vector to search
+// x - the value to count
+//
+// RET: 
+// The number of equal elements. A vector that is NULL, freed or of a 
+// different element size is treated as having no equal element, so the 
+// result is zero. 
+size_t vec_count_i32(const vec_sized_t *v, int32_t x) {
+    if (!simd_check(v, sizeof(x)))
+        return 0;
+    return SIMD_CALL(simd_count_i32, (const int32_t *)v->data, v->len, x);
+}
+
+size_t vec_count_i64(const vec_sized_t *v, int64_t x) {
+    if (!simd_check(v, sizeof(x)))
+        return 0;
+    return SIMD_CALL(simd_count_i64, (const int64_t *)v->data, v->len, x);
+}
+
+size_t vec_count_f32(const vec_sized_t *v, float x) {
+    if (!simd_check(v, sizeof(x)))
+        return 0;
+    return SIMD_CALL(simd_count_f32, (const float *)v->data, v->len, x);
+}
+
+size_t vec_count_f64(const vec_sized_t *v, double x) {
+    if (!simd_check(v, sizeof(x)))
+        return 0;
+    return SIMD_CALL(simd_count_f64, (const double *)v->data, v->len, x);
+}
+
+// Finds the smallest element. 
+//
+// PARAMS: 
+// v   - the vector to search
+// out - where to store the smallest element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_min_i32(const vec_sized_t *v, int32_t *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_min_i32, (const int32_t *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+int vec_min_i64(const vec_sized_t *v, int64_t *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_min_i64, (const int64_t *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+int vec_min_f32(const vec_sized_t *v, float *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_min_f32, (const float *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+int vec_min_f64(const vec_sized_t *v, double *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_min_f64, (const double *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+// Finds the largest element. 
+//
+// PARAMS: 
+// v   - the vector to search
+// out - where to store the largest element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_max_i32(const vec_sized_t *v, int32_t *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_max_i32, (const int32_t *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+int vec_max_i64(const vec_sized_t *v, int64_t *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_max_i64, (const int64_t *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+int vec_max_f32(const vec_sized_t *v, float *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_max_f32, (const float *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+int vec_max_f64(const vec_sized_t *v, double *out) {
+    if (v == NULL || v->data == NULL || out == NULL)
+        return VEC_NULL_ERR;
+    if (v->size != sizeof(*out) || v->len == 0)
+        return VEC_RANGE_ERR;
+    *out = SIMD_CALL(simd_max_f64, (const double *)v->data, v->len);
+    return VEC_GOOD;
+}
+
+// Checks whether the specified vector can be searched as elements of the 
+// given size. 
+//
+// PARAMS: 
+// v    - the vector to check
+// size - the expected element size
+//
+// RET: 
+// True if the vector can be searched. 
+static _Bool simd_check(const vec_sized_t *v, size_t size) {
+    return v != NULL && v->data != NULL && v->size == size;
+}
+
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecsimd.h
+// SIMD search and compare kernels for by-value vectors in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECSIMD_H
+#define VECSIMD_H
+#include "vector.h"
+
+// Every function below needs a by-value vector whose element size matches 
+// the type in its name. The kernel is picked at runtime: AVX2 or SSE2 on 
+// x86-64, NEON on AArch64, scalar code everywhere else. Results for floating 
+// point vectors holding NaN are unspecified. The find and count functions 
+// report any other vector as holding no equal element, while the min and max 
+// functions return an error for it. 
+
+// Finds the first element equal to x. 
+//
+// PARAMS: 
+// v - the vector to search
+// x - the value to search for
+//
+// RET: 
+// The index of the element, or the length if there is none. A vector that 
+// is NULL, freed or of a different element size is treated as having no 
+// equal element, so the result is its length, or zero if it is NULL. 
+size_t vec_find_i32(const vec_sized_t *v, int32_t x);
+size_t vec_find_i64(const vec_sized_t *v, int64_t x);
+size_t vec_find_f32(const vec_sized_t *v, float x);
+size_t vec_find_f64(const vec_sized_t *v, double x);
+
+// Counts the elements equal to x. 
+//
+// PARAMS: 
+// v - the vector to search
+// x - the value to count
+//
+// RET: 
+// The number of equal elements. A vector that is NULL, freed or of a 
+// different element size is treated as having no equal element, so the 
+// result is zero. 
+size_t vec_count_i32(const vec_sized_t *v, int32_t x);
+size_t vec_count_i64(const vec_sized_t *v, int64_t x);
+size_t vec_count_f32(const vec_sized_t *v, float x);
+size_t vec_count_f64(const vec_sized_t *v, double x);
+
+// Finds the smallest element. 
+//
+// PARAMS: 
+// v   - the vector to search
+// out - where to store the smallest element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_min_i32(const vec_sized_t *v, int32_t *out);
+int vec_min_i64(const vec_sized_t *v, int64_t *out);
+int vec_min_f32(const vec_sized_t *v, float *out);
+int vec_min_f64(const vec_sized_t *v, double *out);
+
+// Finds the largest element. 
+//
+// PARAMS: 
+// v   - the vector to search
+// out - where to store the largest element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_max_i32(const vec_sized_t *v, int32_t *out);
+int vec_max_i64(const vec_sized_t *v, int64_t *out);
+int vec_max_f32(const vec_sized_t *v, float *out);
+int vec_max_f64(const vec_sized_t *v, double *out);
+
+#endif
+
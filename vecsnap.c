@@ -0,0 +1,227 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecsnap.c
+// Lock-free snapshot reads over read-mostly vectors in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#define _POSIX_C_SOURCE 200809L
+#include "vecsnap.h"
+
+// A retired version waiting for its readers to leave. 
+struct vec_snap_retired {
+    vec_t *v;                           // the retired version
+    size_t epoch;                       // the epoch it was retired in
+    struct vec_snap_retired *next;      // next retired version
+};
+
+static vec_t *vec_snap_take(vec_t *v);
+static void vec_snap_drop(vec_t *v);
+
+// Initialises the specified snapshot vector, taking over the first version. 
+// The first version is left empty as after vec_free. 
+//
+// PARAMS: 
+// s - the snapshot vector to initialise
+// v - the first version
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_snap_init(vec_snap_t *s, vec_t *v) {
+    if (s == NULL || v == NULL || v->data == NULL)
+        return VEC_NULL_ERR;
+    if (pthread_mutex_init(&s->lock, NULL) != 0)
+        return VEC_ALLOC_ERR;
+
+    s->cur = vec_snap_take(v);
+    if (s->cur == NULL) {
+        pthread_mutex_destroy(&s->lock);
+        return VEC_ALLOC_ERR;
+    }
+    s->epoch = 1;
+    s->readers = NULL;
+    s->retired = NULL;
+    return VEC_GOOD;
+}
+
+// Registers a reader with the snapshot vector. 
+//
+// PARAMS: 
+// s - the snapshot vector to read
+// r - the reader to register
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_snap_register(vec_snap_t *s, vec_snap_reader_t *r) {
+    if (s == NULL || r == NULL)
+        return VEC_NULL_ERR;
+
+    pthread_mutex_lock(&s->lock);
+    __atomic_store_n(&r->epoch, 0, __ATOMIC_RELAXED);
+    r->next = s->readers;
+    s->readers = r;
+    pthread_mutex_unlock(&s->lock);
+    return VEC_GOOD;
+}
+
+// Unregisters a reader from the snapshot vector. The reader must not be 
+// inside a read. 
+//
+// PARAMS: 
+// s - the snapshot vector
+// r - the reader to unregister
+void vec_snap_unregister(vec_snap_t *s, vec_snap_reader_t *r) {
+    if (s == NULL || r == NULL)
+        return;
+
+    pthread_mutex_lock(&s->lock);
+    for (vec_snap_reader_t **p = &s->readers; *p != NULL; p = &(*p)->next) {
+        if (*p == r) {
+            *p = r->next;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+// Starts a read and returns the current version. The version stays valid and 
+// unchanged until vec_snap_leave is called by the same reader. 
+//
+// PARAMS: 
+// s - the snapshot vector to read
+// r - the registered reader
+//
+// RET: 
+// The current version, must not be modified. 
+const vec_t *vec_snap_enter(vec_snap_t *s, vec_snap_reader_t *r) {
+    if (s == NULL || r == NULL)
+        return NULL;
+
+    // announce the epoch before loading the version, so a writer scanning 
+    // the readers after retiring a version sees every reader holding it
+    size_t e = __atomic_load_n(&s->epoch, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&r->epoch, e, __ATOMIC_SEQ_CST);
+    return __atomic_load_n(&s->cur, __ATOMIC_SEQ_CST);
+}
+
+// Ends a read started by vec_snap_enter. 
+//
+// PARAMS: 
+// r - the reader
+void vec_snap_leave(vec_snap_reader_t *r) {
+    if (r != NULL)
+        __atomic_store_n(&r->epoch, 0, __ATOMIC_RELEASE);
+}
+
+// Publishes a new version, taking it over as in vec_snap_init. The previous 
+// version is reclaimed once every reader that could see it has left. 
+//
+// PARAMS: 
+// s - the snapshot vector to publish to
+// v - the new version
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_snap_publish(vec_snap_t *s, vec_t *v) {
+    if (s == NULL || v == NULL || v->data == NULL)
+        return VEC_NULL_ERR;
+
+    struct vec_snap_retired *node = malloc(sizeof *node);
+    if (node == NULL)
+        return VEC_ALLOC_ERR;
+    vec_t *next = vec_snap_take(v);
+    if (next == NULL) {
+        free(node);
+        return VEC_ALLOC_ERR;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    node->v = __atomic_exchange_n(&s->cur, next, __ATOMIC_SEQ_CST);
+    node->epoch = __atomic_fetch_add(&s->epoch, 1, __ATOMIC_SEQ_CST);
+    node->next = s->retired;
+    s->retired = node;
+    pthread_mutex_unlock(&s->lock);
+
+    vec_snap_reclaim(s);
+    return VEC_GOOD;
+}
+
+// Frees retired versions that no reader can see any more. A version retired 
+// in epoch e is only visible to readers that announced an epoch up to e. 
+//
+// PARAMS: 
+// s - the snapshot vector to reclaim
+void vec_snap_reclaim(vec_snap_t *s) {
+    if (s == NULL)
+        return;
+
+    pthread_mutex_lock(&s->lock);
+    size_t oldest = SIZE_MAX;
+    for (vec_snap_reader_t *r = s->readers; r != NULL; r = r->next) {
+        size_t e = __atomic_load_n(&r->epoch, __ATOMIC_SEQ_CST);
+        if (e != 0 && e < oldest)
+            oldest = e;
+    }
+
+    struct vec_snap_retired **p = &s->retired;
+    while (*p != NULL) {
+        struct vec_snap_retired *node = *p;
+        if (node->epoch < oldest) {
+            *p = node->next;
+            vec_snap_drop(node->v);
+            free(node);
+        } else {
+            p = &node->next;
+        }
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+// Frees the snapshot vector and every version. There must be no readers 
+// inside a read. 
+//
+// PARAMS: 
+// s - the snapshot vector to free
+void vec_snap_free(vec_snap_t *s) {
+    if (s == NULL || s->cur == NULL)
+        return;
+
+    while (s->retired != NULL) {
+        struct vec_snap_retired *next = s->retired->next;
+        vec_snap_drop(s->retired->v);
+        free(s->retired);
+        s->retired = next;
+    }
+    vec_snap_drop(s->cur);
+    s->cur = NULL;
+    s->readers = NULL;
+    pthread_mutex_destroy(&s->lock);
+}
+
+// Moves a vector into a new heap allocation, leaving the original empty as 
+// after vec_free. 
+//
+// PARAMS: 
+// v - the vector to move
+//
+// RET: 
+// The moved vector, or NULL on error. 
+static vec_t *vec_snap_take(vec_t *v) {
+    vec_t *ret = malloc(sizeof *ret);
+    if (ret != NULL && vec_take(ret, v) != VEC_GOOD) {
+        free(ret);
+        ret = NULL;
+    }
+    return ret;
+}
+
+// Frees a version moved by vec_snap_take. 
+//
+// PARAMS: 
+// v - the version to free
+static void vec_snap_drop(vec_t *v) {
+    vec_free(v);
+    free(v);
+}
+
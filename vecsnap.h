@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////
+// vecsnap.h
+// Lock-free snapshot reads over read-mostly vectors in C99. 
+//
+// Date:   14/10/2026
+// Author: PotatoMaster101
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef VECSNAP_H
+#define VECSNAP_H
+#include <pthread.h>
+#include "vector.h"
+
+// A reader of a snapshot vector, one per reading thread. 
+typedef struct vec_snap_reader_t {
+    size_t epoch;                       // announced epoch, zero if idle
+    struct vec_snap_reader_t *next;     // next registered reader
+} vec_snap_reader_t;
+
+// A retired version waiting for its readers to leave. 
+struct vec_snap_retired;
+
+// The snapshot vector. Writers publish whole new versions, readers get the 
+// current version without locking and old versions are reclaimed once no 
+// reader can still see them. 
+typedef struct vec_snap_t {
+    vec_t *cur;                         // current version
+    size_t epoch;                       // global epoch, starts at one
+    vec_snap_reader_t *readers;         // registered readers
+    struct vec_snap_retired *retired;   // versions waiting for reclamation
+    pthread_mutex_t lock;               // serialises writers and registration
+} vec_snap_t;
+
+// Initialises the specified snapshot vector, taking over the first version. 
+// The first version is left empty as after vec_free. 
+//
+// PARAMS: 
+// s - the snapshot vector to initialise
+// v - the first version
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_snap_init(vec_snap_t *s, vec_t *v);
+
+// Registers a reader with the snapshot vector. 
+//
+// PARAMS: 
+// s - the snapshot vector to read
+// r - the reader to register
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_snap_register(vec_snap_t *s, vec_snap_reader_t *r);
+
+// Unregisters a reader from the snapshot vector. The reader must not be 
+// inside a read. 
+//
+// PARAMS: 
+// s - the snapshot vector
+// r - the reader to unregister
+void vec_snap_unregister(vec_snap_t *s, vec_snap_reader_t *r);
+
+// Starts a read and returns the current version. The version stays valid and 
+// unchanged until vec_snap_leave is called by the same reader. 
+//
+// PARAMS: 
+// s - the snapshot vector to read
+// r - the registered reader
+//
+// RET: 
+// The current version, must not be modified. 
+const vec_t *vec_snap_enter(vec_snap_t *s, vec_snap_reader_t *r);
+
+// Ends a read started by vec_snap_enter. 
+//
+// PARAMS: 
+// r - the reader
+void vec_snap_leave(vec_snap_reader_t *r);
+
+// Publishes a new version, taking it over as in vec_snap_init. The previous 
+// version is reclaimed once every reader that could see it has left. 
+//
+// PARAMS: 
+// s - the snapshot vector to publish to
+// v - the new version
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_snap_publish(vec_snap_t *s, vec_t *v);
+
+// Frees retired versions that no reader can see any more. A version retired 
+// in epoch e is only visible to readers that announced an epoch up to e. 
+//
+// PARAMS: 
+// s - the snapshot vector to reclaim
+void vec_snap_reclaim(vec_snap_t *s);
+
+// Frees the snapshot vector and every version. There must be no readers 
+// inside a read. 
+//
+// PARAMS: 
+// s - the snapshot vector to free
+void vec_snap_free(vec_snap_t *s);
+
+#endif
+
@@ -8,10 +8,102 @@
 
 #include "vector.h"
 #define DEF_MAX 10
+#define DEF_SLAB 65536
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+#define ISORT_MAX 16
+#define REV_BLOCK 8
+#define SLAB_ALIGN VEC_ARENA_ALIGN
+#define SLAB_HDR \
+    ((sizeof(struct vec_slab) + SLAB_ALIGN - 1) & ~(size_t)(SLAB_ALIGN - 1))
 
+// Counter updates, no code at all unless built with VEC_STATS. 
+#ifdef VEC_STATS
+#define STAT_ADD(v, f, n) vec_stat_add(&(v)->stats.f, &vec_global.f, (n))
+#define STAT_GROW(v, n) vec_stat_grow(&(v)->stats, (v)->max, (n))
+#define STAT_INIT(v) vec_stat_init(&(v)->stats, (v)->max)
+#define STAT_SLAB(s, n) ((s)->copies = (n))
+#define STAT_CARVE(s) ((s)->copies++)
+#define STAT_DROP(v, s) STAT_ADD(v, frees, (s)->copies)
+#else
+#define STAT_ADD(v, f, n) ((void)0)
+#define STAT_GROW(v, n) ((void)0)
+#define STAT_INIT(v) ((void)0)
+#define STAT_SLAB(s, n) ((void)0)
+#define STAT_CARVE(s) ((void)0)
+#define STAT_DROP(v, s) ((void)0)
+#endif
+
+// Element paired with its key for the radix sort. 
+typedef struct vec_keyed_t {
+    uint64_t key;           // the extracted key
+    void *elem;             // the element
+} vec_keyed_t;
+
+// Slab backing the element copies of an arena vector. 
+struct vec_slab {
+    struct vec_slab *next;  // next (older) slab
+    size_t used;            // bytes used
+    size_t cap;             // bytes available
+#ifdef VEC_STATS
+    size_t copies;          // element copies counted in allocs
+#endif
+};
+
+static void *vec_libc_alloc(void *ctx, size_t n);
+static void *vec_libc_resize(void *ctx, void *p, size_t n);
+static void vec_libc_release(void *ctx, void *p);
+static inline void *vec_mem_alloc(const vec_alloc_t *a, size_t n);
+static inline void *vec_mem_resize(const vec_alloc_t *a, void *p, size_t n);
+static void *vec_mem_regrow(const vec_alloc_t *a, void *p, size_t used, 
+        size_t n, _Bool *inl);
+static inline void vec_mem_free(const vec_alloc_t *a, void *p);
 static _Bool vec_fix(vec_t *v);
+static _Bool vec_fit(vec_t *v, size_t n);
+static void vec_isort(void **a, size_t n, 
+        int (*cmp)(const void *, const void *));
+static void vec_sift(void **a, size_t i, size_t n, 
+        int (*cmp)(const void *, const void *));
+static size_t vec_partition(void **a, size_t n, 
+        int (*cmp)(const void *, const void *));
+static void vec_introsort(void **a, size_t n, size_t depth, 
+        int (*cmp)(const void *, const void *));
+static inline void vec_prefetch(void *const *a, size_t i, size_t n);
+static void vec_rev(void **a, size_t n);
+static int vec_relocate_heap(vec_t *v, 
+        size_t (*size)(const void *, void *), void *ctx);
+static size_t vec_grow_max(size_t max, size_t len, size_t n, size_t size, 
+        int grow, size_t step);
+static int vec_setup(vec_t *v, size_t cap, const vec_alloc_t *a, void **buf);
+static int vec_setup_sized(vec_sized_t *v, size_t n, size_t cap, 
+        const vec_alloc_t *a, void *buf);
 static inline _Bool vec_check(vec_t *v);
-static void *vec_new_elem(const void *d, size_t n);
+static void *vec_new_elem(vec_t *v, const void *d, size_t n);
+static inline void vec_free_elem(vec_t *v, void *e);
+static void *vec_slab_alloc(vec_t *v, size_t n);
+static void vec_slab_release(vec_t *v, _Bool keep);
+static _Bool vec_fix_sized(vec_sized_t *v);
+static _Bool vec_fit_sized(vec_sized_t *v, size_t n);
+static inline _Bool vec_check_sized(const vec_sized_t *v);
+static _Bool vec_own(vec_t *v);
+static _Bool vec_own_sized(vec_sized_t *v);
+#ifdef VEC_STATS
+static inline void vec_stat_add(size_t *own, size_t *all, size_t n);
+static void vec_stat_peak(vec_stats_t *s, size_t max);
+static void vec_stat_grow(vec_stats_t *s, size_t max, size_t n);
+static void vec_stat_init(vec_stats_t *s, size_t max);
+static void vec_stat_load(vec_stats_t *out);
+static void vec_stat_clear(void);
+
+// Counters summed over every vector. 
+static vec_stats_t vec_global;
+#endif
+
+// The default allocator. 
+static const vec_alloc_t vec_libc = {
+    vec_libc_alloc, vec_libc_resize, vec_libc_release, NULL
+};
 
 // Initialises the specified vector. 
 //
@@ -21,19 +113,88 @@ static void *vec_new_elem(const void *d, size_t n);
 // RET: 
 // Zero on success, non-zero on error. 
 int vec_init(vec_t *v) {
-    if (v == NULL)
-        return VEC_NULL_ERR;
+    return vec_setup(v, DEF_MAX, NULL, NULL);
+}
 
-    int ret = VEC_GOOD;
-    v->len = 0;
-    v->max = DEF_MAX;
-    v->data = malloc(DEF_MAX * sizeof(void *));
-    if (v->data == NULL)
-        ret = VEC_ALLOC_ERR;
+// Initialises the specified vector with room for exactly n elements. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_cap(vec_t *v, size_t n) {
+    return vec_setup(v, n, NULL, NULL);
+}
+
+// Initialises the specified vector with an arena. Element copies will be 
+// carved from slabs of n bytes, and are released together by vec_clear or 
+// vec_free. Elements returned by vec_del must not be freed by the caller, 
+// they stay valid until the vector is cleared or freed. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each slab, zero for the default
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_arena(vec_t *v, size_t n) {
+    return vec_init_arena_alloc(v, n, NULL);
+}
+
+// Initialises the specified vector with an allocator. Elements returned by 
+// vec_del must be freed using the same allocator. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// a - the allocator, NULL for malloc, realloc and free
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_alloc(vec_t *v, const vec_alloc_t *a) {
+    return vec_setup(v, DEF_MAX, a, NULL);
+}
+
+// Initialises the specified vector with an arena and an allocator. Both the 
+// pointer buffer and the slabs will come from the allocator. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each slab, zero for the default
+// a - the allocator, NULL for malloc, realloc and free
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_arena_alloc(vec_t *v, size_t n, const vec_alloc_t *a) {
+    int ret = vec_init_alloc(v, a);
+    if (ret == VEC_GOOD)
+        v->slabsz = (n == 0) ? DEF_SLAB : n;
     return ret;
 }
 
-// Reserves n elements in the specified vector. 
+// Initialises the specified vector on top of a buffer of cap slots that is 
+// not owned by the vector, such as a local array. No allocation is made 
+// until the vector outgrows the buffer, its slots are then copied to the 
+// heap. The buffer is never resized or freed and must outlive the vector. 
+//
+// PARAMS: 
+// v   - the vector to initialise
+// buf - the buffer of slots
+// cap - the number of slots in the buffer
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_buf(vec_t *v, void **buf, size_t cap) {
+    if (buf == NULL)
+        return VEC_NULL_ERR;
+    if (cap == 0)
+        return VEC_RANGE_ERR;
+    return vec_setup(v, cap, NULL, buf);
+}
+
+// Reserves n elements in the specified vector. The buffer is resized to 
+// exactly n elements, nothing is done if it can already hold n elements. 
 //
 // PARAMS: 
 // v - the vector to reserve
@@ -42,223 +203,2277 @@ int vec_init(vec_t *v) {
 // RET: 
 // Zero on success, non-zero on error. 
 int vec_reserve(vec_t *v, size_t n) {
-    if (v == NULL)
+    if (!vec_check(v))
         return VEC_NULL_ERR;
     if (n <= v->max)
-        return VEC_RANGE_ERR;
+        return VEC_GOOD;
+    if (n > SIZE_MAX / sizeof(void *))
+        return VEC_ALLOC_ERR;
 
     int ret = VEC_ALLOC_ERR;
-    void **res = realloc(v->data, n * v->max * (sizeof *res));
+    void **res = vec_mem_regrow(v->alloc, v->data, v->len * (sizeof *res), 
+            n * (sizeof *res), &v->inl);
     if (res != NULL) {
         ret = VEC_GOOD;
         v->max = n;
         v->data = res;
+        STAT_GROW(v, n * (sizeof *res));
     }
     return ret;
 }
 
-// Sorts the specified vector using the comparison function. 
+// Shrinks the buffer of the specified vector to its current length. A vector 
+// still on a buffer it does not own is left as is. 
 //
 // PARAMS: 
-// v   - the vector to sort
-// cmp - the comparison function
+// v - the vector to shrink
 //
 // RET: 
 // Zero on success, non-zero on error. 
-int vec_sort(vec_t *v, int (*cmp)(const void *, const void *)) {
-    if (!vec_check(v) || cmp == NULL)
+int vec_shrink_to_fit(vec_t *v) {
+    if (!vec_check(v))
         return VEC_NULL_ERR;
-    if (v->len != 0)
-        qsort(v->data, v->len, sizeof(void *), cmp);
-    return VEC_GOOD;
+
+    size_t n = (v->len == 0) ? 1 : v->len;  // keep the buffer valid
+    if (n == v->max || v->inl)
+        return VEC_GOOD;
+
+    int ret = VEC_ALLOC_ERR;
+    void **res = vec_mem_resize(v->alloc, v->data, n * (sizeof *res));
+    if (res != NULL) {
+        ret = VEC_GOOD;
+        v->max = n;
+        v->data = res;
+        STAT_ADD(v, realloc_bytes, n * (sizeof *res));
+    }
+    return ret;
 }
 
-// Adds a new element into the specified vector. The new element will be 
-// copied. 
+// Sets the growth policy of the specified vector. 
 //
 // PARAMS: 
-// v - the vector to add the element
-// d - the element to add
-// n - the size of the element
+// v    - the vector to set
+// grow - VEC_GROW_DOUBLE, VEC_GROW_HALF or VEC_GROW_STEP
+// step - number of elements to grow by for VEC_GROW_STEP
 //
 // RET: 
 // Zero on success, non-zero on error. 
-int vec_add(vec_t *v, const void *d, size_t n) {
-    if (!vec_check(v))
+int vec_set_growth(vec_t *v, int grow, size_t step) {
+    if (v == NULL)
         return VEC_NULL_ERR;
-    if (!vec_fix(v))
-        return VEC_ALLOC_ERR;
+    if (grow < VEC_GROW_DOUBLE || grow > VEC_GROW_STEP)
+        return VEC_RANGE_ERR;
+    if (grow == VEC_GROW_STEP && step == 0)
+        return VEC_RANGE_ERR;
 
-    int ret = VEC_ALLOC_ERR;
-    void *elem = vec_new_elem(d, n);
-    if (elem != NULL) {
-        v->data[v->len++] = elem;
-        ret = VEC_GOOD;
-    }
-    return ret;
+    v->grow = grow;
+    v->step = step;
+    return VEC_GOOD;
 }
 
-// Inserts a new element into the specified vector. The new element will be 
-// copied. 
+// Turns tombstone mode on or off for the specified vector. In tombstone mode 
+// vec_del only marks the slot dead by setting it to NULL, so it runs in 
+// constant time and indices keep referring to raw slots. Loops over the 
+// slots must skip NULL ones, vec_foreach and the parallel walks do. Dead 
+// slots are squeezed out by vec_compact, which runs on its own once they 
+// reach pct percent of the length, and before any sort. The binary searches 
+// take a const vector and need it compacted first. 
 //
 // PARAMS: 
-// v - the vector to insert the element
-// d - the element to insert
-// n - the size of the element
-// i - the index to insert to
+// v   - the vector to set
+// pct - the dead percentage that triggers compaction, zero turns it off
 //
 // RET: 
 // Zero on success, non-zero on error. 
-int vec_ins(vec_t *v, const void *d, size_t n, size_t i) {
+int vec_set_tombstones(vec_t *v, unsigned pct) {
     if (!vec_check(v))
         return VEC_NULL_ERR;
-    if (i >= v->len)
-        return vec_add(v, d, n);    // add to last if out of range
-    if (!vec_fix(v))
-        return VEC_ALLOC_ERR;
+    if (pct > 100)
+        return VEC_RANGE_ERR;
 
-    int ret = VEC_ALLOC_ERR;
-    void *elem = vec_new_elem(d, n);
-    if (elem != NULL) {
-        size_t sh = v->len - i;
-        memmove(v->data + i + 1, v->data + i, sh * sizeof(void *));
-        v->data[i] = elem;
-        v->len++;
-        ret = VEC_GOOD;
-    }
-    return ret;
+    if (pct == 0)
+        vec_compact(v);
+    v->tomb = pct;
+    return VEC_GOOD;
 }
 
-// Deletes an element in the vector specified by the index. 
+// Removes the dead slots left by tombstone deletes, keeping the order of the 
+// live elements. Indices of the live elements change. 
 //
 // PARAMS: 
-// v - the vector to delete the element
-// i - the index of the element
+// v - the vector to compact
 //
 // RET: 
-// The deleted element, or NULL on error. 
-void *vec_del(vec_t *v, size_t i) {
-    if (!vec_check(v))
-        return NULL;
+// The number of slots removed. 
+size_t vec_compact(vec_t *v) {
+    if (!vec_check(v) || v->ndead == 0)
+        return 0;
 
-    void *ret = NULL;
-    if (i >= v->len - 1) {  // remove last if out of range
-        ret = v->data[v->len - 1];
-    } else {
-        ret = v->data[i];
-        size_t shift = v->len - i;
-        memmove(v->data + i, v->data + i + 1, shift * sizeof(void *));
-    }
-    v->data[--v->len] = NULL;
+    size_t w = 0;
+    for (size_t r = 0; r < v->len; r++)
+        if (v->data[r] != NULL)
+            v->data[w++] = v->data[r];
+
+    size_t ret = v->len - w;
+    v->len = w;
+    v->ndead = 0;
     return ret;
 }
 
-// Deletes a range of elements in the specified vector. 
+// Copies every live element to new memory in index order, so walks and sorts 
+// touch memory sequentially again after heavy churn, then frees the old 
+// copies. An arena vector is repacked into one slab. A vector without an 
+// arena keeps its ownership rules and gets one new allocation per element in 
+// index order, unless arena is true, in which case it is repacked into one 
+// slab and becomes an arena vector as if made by vec_init_arena: elements 
+// returned by vec_del must then not be freed, deleted elements are only 
+// released by vec_clear or vec_free, and vec_add_owned fails. Nothing is 
+// changed on error. 
 //
 // PARAMS: 
-// v - the vector to delete the elements
-// i - the starting index to delete
-// n - the number of elements to delete
-void vec_delrange(vec_t *v, size_t i, size_t n) {
-    if (!vec_check(v) || n == 0)
-        return;
+// v     - the vector to relocate
+// size  - returns the size in bytes of an element, receives the context
+// ctx   - the context passed to the size function
+// arena - whether a vector without an arena may become an arena vector
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_relocate_contiguous(vec_t *v, size_t (*size)(const void *, void *), 
+        void *ctx, bool arena) {
+    if (!vec_check(v) || size == NULL)
+        return VEC_NULL_ERR;
+    if (v->slabsz == 0 && !arena)
+        return vec_relocate_heap(v, size, ctx);
 
-    // fix i and n if they are out of range
-    i = (i >= v->len) ? (v->len - 1) : i;
-    n = (n > v->len - i) ? (v->len - i) : n;
+    // every copy is rounded up to the arena alignment, size the block for it
+    size_t total = 0, lim = SIZE_MAX - SLAB_HDR - SLAB_ALIGN;
+    for (size_t i = 0; i < v->len; i++) {
+        if (v->data[i] == NULL)
+            continue;   // dead slot
+        size_t n = size(v->data[i], ctx);
+        if (n == 0)
+            return VEC_RANGE_ERR;
+        if (n > lim || total > lim - n)
+            return VEC_ALLOC_ERR;
+        total += (n + SLAB_ALIGN - 1) & ~(size_t)(SLAB_ALIGN - 1);
+    }
 
-    size_t left = v->len - (i + n);
-    for (size_t j = 0; j < n; j++)
-        free(v->data[i + j]);
-    if (left != 0)
-        memmove(v->data + i, v->data + i + n, left * sizeof(void *));
-    v->len -= n;
+    struct vec_slab *s = NULL;
+    if (total != 0) {
+        s = vec_mem_alloc(v->alloc, SLAB_HDR + total);
+        if (s == NULL)
+            return VEC_ALLOC_ERR;
+        s->next = NULL;
+        s->used = 0;
+        s->cap = total;
+        STAT_SLAB(s, 1);
+        STAT_ADD(v, allocs, 1);
+    }
+
+    // the size function is asked again rather than keeping every size
+    for (size_t i = 0; i < v->len; i++) {
+        void *elem = v->data[i];
+        if (elem == NULL)
+            continue;
+        vec_prefetch(v->data, i, v->len);
+        size_t n = size(elem, ctx);
+        void *copy = (unsigned char *)s + SLAB_HDR + s->used;
+        memcpy(copy, elem, n);
+        s->used += (n + SLAB_ALIGN - 1) & ~(size_t)(SLAB_ALIGN - 1);
+        vec_free_elem(v, elem);
+        v->data[i] = copy;
+    }
+
+    if (v->slabsz != 0)
+        vec_slab_release(v, false);
+    else
+        v->slabsz = DEF_SLAB;
+    v->slab = s;
+    return VEC_GOOD;
 }
 
-// Reverts every element in the vector. 
+// Sorts the specified vector using the comparison function. The partitions 
+// prefetch the elements they are about to compare. 
 //
 // PARAMS: 
-// v - the vector to reverse. 
-void vec_reverse(vec_t *v) {
-    if (vec_check(v)) {
-        for (size_t i = 0; i < (v->len / 2); i++) {
-            void *swap = v->data[i];
-            v->data[i] = v->data[v->len - i - 1];
-            v->data[v->len - i - 1] = swap;
+// v   - the vector to sort
+// cmp - the comparison function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort(vec_t *v, int (*cmp)(const void *, const void *)) {
+    if (!vec_check(v) || cmp == NULL)
+        return VEC_NULL_ERR;
+    vec_compact(v);
+
+    size_t depth = 0;
+    for (size_t n = v->len; n > 1; n >>= 1)
+        depth += 2;
+    vec_introsort(v->data, v->len, depth, cmp);
+    return VEC_GOOD;
+}
+
+// Partially sorts the vector so the element at index k is the one that would 
+// be there if the vector was sorted, with no greater element before it and 
+// no smaller element after it. Runs in linear time on average. 
+//
+// PARAMS: 
+// v   - the vector to partially sort
+// k   - the index of the element to place
+// cmp - the comparison function, the same as for vec_sort
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_nth_element(vec_t *v, size_t k, 
+        int (*cmp)(const void *, const void *)) {
+    if (!vec_check(v) || cmp == NULL)
+        return VEC_NULL_ERR;
+    vec_compact(v);
+    if (k >= v->len)
+        return VEC_RANGE_ERR;
+
+    size_t lo = 0, hi = v->len, depth = 0;
+    for (size_t n = v->len; n > 1; n >>= 1)
+        depth += 2;
+    while (hi - lo > ISORT_MAX) {
+        if (depth-- == 0) {     // too many bad pivots, fall back to sorting
+            qsort(v->data + lo, hi - lo, sizeof(void *), cmp);
+            return VEC_GOOD;
         }
+
+        size_t left = lo + vec_partition(v->data + lo, hi - lo, cmp);
+        if (k < left)
+            hi = left;
+        else
+            lo = left;
     }
+    vec_isort(v->data + lo, hi - lo, cmp);
+    return VEC_GOOD;
 }
 
-// Clears the specified vector, freeing all elements. 
+// Sorts the k smallest elements of the vector into its first k slots, the 
+// order of the rest is unspecified. Runs in O(n log k) time. 
 //
 // PARAMS: 
-// v - the vector to clear
-void vec_clear(vec_t *v) {
-    if (vec_check(v)) {
-        for (size_t i = 0; i < v->len; i++)
-            free(v->data[i]);
-        v->len = 0;
+// v   - the vector to partially sort
+// k   - the number of elements to sort
+// cmp - the comparison function, the same as for vec_sort
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_partial_sort(vec_t *v, size_t k, 
+        int (*cmp)(const void *, const void *)) {
+    if (!vec_check(v) || cmp == NULL)
+        return VEC_NULL_ERR;
+    vec_compact(v);
+    if (k >= v->len)
+        return vec_sort(v, cmp);
+    if (k == 0)
+        return VEC_GOOD;
+
+    // keep the k smallest in a max-heap at the front
+    void **a = v->data;
+    for (size_t i = k / 2; i > 0; i--)
+        vec_sift(a, i - 1, k, cmp);
+    for (size_t i = k; i < v->len; i++) {
+        if (cmp(&a[i], &a[0]) < 0) {
+            void *swap = a[0];
+            a[0] = a[i];
+            a[i] = swap;
+            vec_sift(a, 0, k, cmp);
+        }
+    }
+
+    for (size_t i = k - 1; i > 0; i--) {
+        void *swap = a[0];
+        a[0] = a[i];
+        a[i] = swap;
+        vec_sift(a, 0, i, cmp);
     }
+    return VEC_GOOD;
 }
 
-// Frees the internal buffer in the specified vector. 
+// Sorts the specified vector by an unsigned key extracted once from every 
+// element, using a stable radix sort. Use the vec_key_* functions to map 
+// signed or floating point keys to unsigned ones with the same order. 
 //
 // PARAMS: 
-// v - the vector to free
-void vec_free(vec_t *v) {
-    if (vec_check(v)) {
-        for (size_t i = 0; i < v->len; i++)
-            free(v->data[i]);
-        free(v->data);
-        v->data = NULL;
+// v   - the vector to sort
+// key - the key extraction function, receives an element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_by_key(vec_t *v, uint64_t (*key)(const void *)) {
+    if (!vec_check(v) || key == NULL)
+        return VEC_NULL_ERR;
+    vec_compact(v);
+    if (v->len < 2)
+        return VEC_GOOD;
+    if (v->len > SIZE_MAX / (2 * sizeof(vec_keyed_t)))
+        return VEC_ALLOC_ERR;
+
+    size_t len = v->len;
+    vec_keyed_t *a = vec_mem_alloc(v->alloc, 2 * len * sizeof *a);
+    if (a == NULL)
+        return VEC_ALLOC_ERR;
+
+    // extract the keys and count every digit in one pass
+    size_t (*count)[RADIX_SIZE] = vec_mem_alloc(v->alloc, 
+            RADIX_PASSES * sizeof *count);
+    if (count == NULL) {
+        vec_mem_free(v->alloc, a);
+        return VEC_ALLOC_ERR;
+    }
+    memset(count, 0, RADIX_PASSES * sizeof *count);
+    for (size_t i = 0; i < len; i++) {
+        vec_prefetch(v->data, i, len);
+        uint64_t k = key(v->data[i]);
+        a[i].key = k;
+        a[i].elem = v->data[i];
+        for (int p = 0; p < RADIX_PASSES; p++)
+            count[p][(k >> (p * RADIX_BITS)) & (RADIX_SIZE - 1)]++;
     }
+
+    vec_keyed_t *src = a, *dst = a + len;
+    for (int p = 0; p < RADIX_PASSES; p++) {
+        size_t *c = count[p];
+        uint64_t k0 = (src[0].key >> (p * RADIX_BITS)) & (RADIX_SIZE - 1);
+        if (c[k0] == len)
+            continue;   // every key shares this digit
+
+        size_t sum = 0;
+        for (size_t d = 0; d < RADIX_SIZE; d++) {
+            size_t n = c[d];
+            c[d] = sum;
+            sum += n;
+        }
+        for (size_t i = 0; i < len; i++) {
+            uint64_t d = (src[i].key >> (p * RADIX_BITS)) & (RADIX_SIZE - 1);
+            dst[c[d]++] = src[i];
+        }
+
+        vec_keyed_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    for (size_t i = 0; i < len; i++)
+        v->data[i] = src[i].elem;
+    vec_mem_free(v->alloc, count);
+    vec_mem_free(v->alloc, a);
+    return VEC_GOOD;
 }
 
-// Fixes the buffer of the vector, reallocates if needed. 
+// Finds the first element not ordered before the key in a vector sorted by 
+// the comparison function. The comparison function is the same as for 
+// vec_sort, it receives pointers to element pointers. 
 //
 // PARAMS: 
-// v - the vector to fix
+// v   - the sorted vector to search
+// key - the element to search for
+// cmp - the comparison function
 //
 // RET: 
-// True if the vector has enough storage for one more element, false 
-// otherwise. 
-static _Bool vec_fix(vec_t *v) {
-    if (v->len < v->max)
-        return true;    // space enough
+// The index of the element, or the length if there is none. 
+size_t vec_lower_bound(const vec_t *v, const void *key, 
+        int (*cmp)(const void *, const void *)) {
+    if (v == NULL || v->data == NULL || cmp == NULL)
+        return 0;
 
-    _Bool ret = false;
-    void **temp = realloc(v->data, 2 * v->max * (sizeof *temp));
-    if (temp != NULL) {
-        ret = true;
-        v->max *= 2;
-        v->data = temp;
+    size_t lo = 0, n = v->len;
+    while (n > 0) {
+        size_t h = n / 2;
+        VEC_PREFETCH(v->data[lo + h / 2]);  // both possible next probes
+        if (n - h > 1)
+            VEC_PREFETCH(v->data[lo + h + 1 + (n - h - 1) / 2]);
+        if (cmp(&v->data[lo + h], &key) < 0) {
+            lo += h + 1;
+            n -= h + 1;
+        } else {
+            n = h;
+        }
     }
-    return ret;
+    return lo;
 }
 
-// Checks whether the vector is valid. 
+// Finds the first element ordered after the key in a vector sorted by the 
+// comparison function. The comparison function is the same as for vec_sort. 
 //
 // PARAMS: 
-// v - the vector to check
+// v   - the sorted vector to search
+// key - the element to search for
+// cmp - the comparison function
 //
 // RET: 
-// True if the vector is in valid state, false otherwise. 
-static inline _Bool vec_check(vec_t *v) {
-    return (v != NULL && v->data != NULL);
+// The index of the element, or the length if there is none. 
+size_t vec_upper_bound(const vec_t *v, const void *key, 
+        int (*cmp)(const void *, const void *)) {
+    if (v == NULL || v->data == NULL || cmp == NULL)
+        return 0;
+
+    size_t lo = 0, n = v->len;
+    while (n > 0) {
+        size_t h = n / 2;
+        VEC_PREFETCH(v->data[lo + h / 2]);  // both possible next probes
+        if (n - h > 1)
+            VEC_PREFETCH(v->data[lo + h + 1 + (n - h - 1) / 2]);
+        if (cmp(&key, &v->data[lo + h]) >= 0) {
+            lo += h + 1;
+            n -= h + 1;
+        } else {
+            n = h;
+        }
+    }
+    return lo;
 }
 
-// Returns a copy of the specified element. 
+// Searches for an element equal to the key in a vector sorted by the 
+// comparison function. The comparison function is the same as for vec_sort. 
 //
 // PARAMS: 
-// d - the element to copy
-// n - the size of the element
-static void *vec_new_elem(const void *d, size_t n) {
-    if (d == NULL || n == 0)
+// v   - the sorted vector to search
+// key - the element to search for
+// cmp - the comparison function
+//
+// RET: 
+// The first equal element, or NULL if there is none. 
+void *vec_bsearch(const vec_t *v, const void *key, 
+        int (*cmp)(const void *, const void *)) {
+    size_t i = vec_lower_bound(v, key, cmp);
+    if (v == NULL || v->data == NULL || cmp == NULL || i >= v->len)
         return NULL;
+    return (cmp(&v->data[i], &key) == 0) ? v->data[i] : NULL;
+}
 
-    void *ret = malloc(n);
-    if (ret != NULL)
-        memcpy(ret, d, n);
-    return ret;
+// Inserts a new element into a vector sorted by the comparison function, 
+// after any equal elements. The new element will be copied. 
+//
+// PARAMS: 
+// v   - the sorted vector to insert the element
+// d   - the element to insert
+// n   - the size of the element
+// cmp - the comparison function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_sorted(vec_t *v, const void *d, size_t n, 
+        int (*cmp)(const void *, const void *)) {
+    if (!vec_check(v) || cmp == NULL)
+        return VEC_NULL_ERR;
+    vec_compact(v);
+    return vec_ins(v, d, n, vec_upper_bound(v, d, cmp));
 }
 
+// Adds a new element into the specified vector. The new element will be 
+// copied. 
+//
+// PARAMS: 
+// v - the vector to add the element
+// d - the element to add
+// n - the size of the element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add(vec_t *v, const void *d, size_t n) {
+    if (!vec_check(v))
+        return VEC_NULL_ERR;
+    if (!vec_fix(v))
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_ALLOC_ERR;
+    void *elem = vec_new_elem(v, d, n);
+    if (elem != NULL) {
+        v->data[v->len++] = elem;
+        ret = VEC_GOOD;
+    }
+    return ret;
+}
+
+// Adds an element allocated by the caller into the specified vector without 
+// copying it. The vector takes ownership and frees the element with its 
+// allocator, so the element must come from that allocator. Arena vectors 
+// cannot adopt elements. 
+//
+// PARAMS: 
+// v - the vector to add the element
+// d - the element to adopt
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_owned(vec_t *v, void *d) {
+    if (!vec_check(v) || d == NULL)
+        return VEC_NULL_ERR;
+    if (v->slabsz != 0)
+        return VEC_RANGE_ERR;
+    if (!vec_fix(v))
+        return VEC_ALLOC_ERR;
+
+    v->data[v->len++] = d;
+    return VEC_GOOD;
+}
+
+// Adds count elements from a contiguous array into the specified vector. The 
+// buffer grows at most once and every element will be copied. Nothing is 
+// added on error. 
+//
+// PARAMS: 
+// v     - the vector to add the elements
+// src   - the array of elements
+// count - the number of elements
+// n     - the size of each element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_many(vec_t *v, const void *src, size_t count, size_t n) {
+    if (!vec_check(v) || src == NULL)
+        return VEC_NULL_ERR;
+    if (n == 0)
+        return VEC_RANGE_ERR;
+    if (count == 0)
+        return VEC_GOOD;
+    if (!vec_fit(v, count))
+        return VEC_ALLOC_ERR;
+
+    const unsigned char *d = src;
+    size_t len = v->len;
+    for (size_t i = 0; i < count; i++) {
+        void *elem = vec_new_elem(v, d + i * n, n);
+        if (elem == NULL) {
+            while (v->len > len)    // roll back the partial batch
+                vec_free_elem(v, v->data[--v->len]);
+            return VEC_ALLOC_ERR;
+        }
+        v->data[v->len++] = elem;
+    }
+    return VEC_GOOD;
+}
+
+// Appends copies of every element in src to dst. The buffer grows at most 
+// once. Nothing is added on error. 
+//
+// PARAMS: 
+// dst - the vector to append to
+// src - the vector to copy from
+// n   - the size of each element in src
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_extend(vec_t *dst, const vec_t *src, size_t n) {
+    if (!vec_check(dst) || src == NULL || src->data == NULL)
+        return VEC_NULL_ERR;
+    if (n == 0)
+        return VEC_RANGE_ERR;
+
+    size_t count = src->len;    // dst may be src
+    if (!vec_fit(dst, count))
+        return VEC_ALLOC_ERR;
+
+    size_t len = dst->len;
+    for (size_t i = 0; i < count; i++) {
+        if (src->data[i] == NULL)
+            continue;   // dead slot
+        vec_prefetch(src->data, i, count);
+        void *elem = vec_new_elem(dst, src->data[i], n);
+        if (elem == NULL) {
+            while (dst->len > len)  // roll back the partial batch
+                vec_free_elem(dst, dst->data[--dst->len]);
+            return VEC_ALLOC_ERR;
+        }
+        dst->data[dst->len++] = elem;
+    }
+    return VEC_GOOD;
+}
+
+// Inserts a new element into the specified vector. The new element will be 
+// copied. 
+//
+// PARAMS: 
+// v - the vector to insert the element
+// d - the element to insert
+// n - the size of the element
+// i - the index to insert to
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins(vec_t *v, const void *d, size_t n, size_t i) {
+    if (!vec_check(v))
+        return VEC_NULL_ERR;
+    if (i >= v->len)
+        return vec_add(v, d, n);    // add to last if out of range
+    if (!vec_fix(v))
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_ALLOC_ERR;
+    void *elem = vec_new_elem(v, d, n);
+    if (elem != NULL) {
+        size_t sh = v->len - i;
+        memmove(v->data + i + 1, v->data + i, sh * sizeof(void *));
+        STAT_ADD(v, move_bytes, sh * sizeof(void *));
+        v->data[i] = elem;
+        v->len++;
+        ret = VEC_GOOD;
+    }
+    return ret;
+}
+
+// Inserts an element allocated by the caller into the specified vector 
+// without copying it, ownership is taken as in vec_add_owned. 
+//
+// PARAMS: 
+// v - the vector to insert the element
+// d - the element to adopt
+// i - the index to insert to
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_owned(vec_t *v, void *d, size_t i) {
+    if (!vec_check(v) || d == NULL)
+        return VEC_NULL_ERR;
+    if (v->slabsz != 0)
+        return VEC_RANGE_ERR;
+    if (i >= v->len)
+        return vec_add_owned(v, d);     // add to last if out of range
+    if (!vec_fix(v))
+        return VEC_ALLOC_ERR;
+
+    memmove(v->data + i + 1, v->data + i, (v->len - i) * sizeof(void *));
+    STAT_ADD(v, move_bytes, (v->len - i) * sizeof(void *));
+    v->data[i] = d;
+    v->len++;
+    return VEC_GOOD;
+}
+
+// Inserts count elements from a contiguous array into the specified vector. 
+// The tail is shifted once and every element will be copied. Nothing is 
+// inserted on error. 
+//
+// PARAMS: 
+// v     - the vector to insert the elements
+// i     - the index to insert to
+// src   - the array of elements
+// count - the number of elements
+// n     - the size of each element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_range(vec_t *v, size_t i, const void *src, size_t count, size_t n) {
+    if (!vec_check(v) || src == NULL)
+        return VEC_NULL_ERR;
+    if (i >= v->len)
+        return vec_add_many(v, src, count, n);  // add to last if out of range
+    if (n == 0)
+        return VEC_RANGE_ERR;
+    if (count == 0)
+        return VEC_GOOD;
+    if (!vec_fit(v, count))
+        return VEC_ALLOC_ERR;
+
+    size_t sh = v->len - i;
+    memmove(v->data + i + count, v->data + i, sh * sizeof(void *));
+    STAT_ADD(v, move_bytes, sh * sizeof(void *));
+
+    const unsigned char *d = src;
+    for (size_t j = 0; j < count; j++) {
+        void *elem = vec_new_elem(v, d + j * n, n);
+        if (elem == NULL) {
+            while (j > 0)   // roll back the partial batch
+                vec_free_elem(v, v->data[i + --j]);
+            memmove(v->data + i, v->data + i + count, sh * sizeof(void *));
+            return VEC_ALLOC_ERR;
+        }
+        v->data[i + j] = elem;
+    }
+    v->len += count;
+    return VEC_GOOD;
+}
+
+// Deletes an element in the vector specified by the index. In tombstone mode 
+// the slot is only marked dead, see vec_set_tombstones. 
+//
+// PARAMS: 
+// v - the vector to delete the element
+// i - the index of the element
+//
+// RET: 
+// The deleted element, or NULL on error. 
+void *vec_del(vec_t *v, size_t i) {
+    if (!vec_check(v) || v->len == 0)
+        return NULL;
+
+    void *ret = NULL;
+    if (v->tomb != 0) {
+        i = (i >= v->len) ? (v->len - 1) : i;
+        ret = v->data[i];
+        if (ret != NULL) {
+            v->data[i] = NULL;
+            if (++v->ndead * 100 >= v->len * v->tomb)
+                vec_compact(v);
+        }
+        return ret;
+    }
+
+    if (i >= v->len - 1) {  // remove last if out of range
+        ret = v->data[v->len - 1];
+    } else {
+        ret = v->data[i];
+        size_t shift = v->len - i - 1;
+        memmove(v->data + i, v->data + i + 1, shift * sizeof(void *));
+        STAT_ADD(v, move_bytes, shift * sizeof(void *));
+    }
+    v->data[--v->len] = NULL;
+    return ret;
+}
+
+// Removes an element in the vector specified by the index by moving the last 
+// element into its slot. Runs in constant time but does not keep the order. 
+//
+// PARAMS: 
+// v - the vector to remove the element
+// i - the index of the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *vec_swap_remove(vec_t *v, size_t i) {
+    if (!vec_check(v) || i >= v->len)
+        return NULL;
+
+    void *ret = v->data[i];
+    if (ret == NULL)
+        v->ndead--;     // removing a dead slot
+    v->data[i] = v->data[--v->len];
+    v->data[v->len] = NULL;
+    return ret;
+}
+
+// Removes the last element in the specified vector. 
+//
+// PARAMS: 
+// v - the vector to remove the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *vec_pop(vec_t *v) {
+    if (!vec_check(v))
+        return NULL;
+    while (v->ndead != 0 && v->len != 0 && v->data[v->len - 1] == NULL) {
+        v->len--;       // drop trailing dead slots
+        v->ndead--;
+    }
+    if (v->len == 0)
+        return NULL;
+
+    void *ret = v->data[--v->len];
+    v->data[v->len] = NULL;
+    return ret;
+}
+
+// Deletes a range of elements in the specified vector. 
+//
+// PARAMS: 
+// v - the vector to delete the elements
+// i - the starting index to delete
+// n - the number of elements to delete
+void vec_delrange(vec_t *v, size_t i, size_t n) {
+    if (!vec_check(v) || n == 0 || v->len == 0)
+        return;
+
+    // fix i and n if they are out of range
+    i = (i >= v->len) ? (v->len - 1) : i;
+    n = (n > v->len - i) ? (v->len - i) : n;
+
+    size_t left = v->len - (i + n);
+    for (size_t j = 0; j < n; j++) {
+        if (v->data[i + j] == NULL)
+            v->ndead--;     // already dead
+        vec_free_elem(v, v->data[i + j]);
+    }
+    if (left != 0) {
+        memmove(v->data + i, v->data + i + n, left * sizeof(void *));
+        STAT_ADD(v, move_bytes, left * sizeof(void *));
+    }
+    v->len -= n;
+}
+
+// Keeps only the elements accepted by the predicate, freeing the others. The 
+// order of the kept elements is preserved and the vector is walked once. 
+//
+// PARAMS: 
+// v    - the vector to filter
+// keep - the predicate, receives an element and the context
+// ctx  - the context passed to the predicate
+//
+// RET: 
+// The number of elements removed. 
+size_t vec_retain(vec_t *v, bool (*keep)(const void *, void *), void *ctx) {
+    if (!vec_check(v) || keep == NULL)
+        return 0;
+
+    size_t w = 0;
+    for (size_t r = 0; r < v->len; r++) {
+        void *elem = v->data[r];
+        if (elem == NULL)
+            continue;   // dead slot, dropped without counting
+        vec_prefetch(v->data, r, v->len);
+        if (keep(elem, ctx))
+            v->data[w++] = elem;
+        else
+            vec_free_elem(v, elem);
+    }
+
+    size_t ret = v->len - w - v->ndead;
+    v->len = w;
+    v->ndead = 0;
+    return ret;
+}
+
+// Calls the function on every element of the vector, in order. Dead slots 
+// are skipped, and the element VEC_PREFETCH_DIST slots ahead is prefetched 
+// before each call. 
+//
+// PARAMS: 
+// v   - the vector to walk
+// fn  - the function, receives an element and the context
+// ctx - the context passed to the function
+void vec_foreach(const vec_t *v, void (*fn)(void *, void *), void *ctx) {
+    if (v == NULL || v->data == NULL || fn == NULL)
+        return;
+
+    for (size_t i = 0; i < v->len; i++) {
+        vec_prefetch(v->data, i, v->len);
+        if (v->data[i] != NULL)
+            fn(v->data[i], ctx);
+    }
+}
+
+// Reverts every element in the vector. 
+//
+// PARAMS: 
+// v - the vector to reverse. 
+void vec_reverse(vec_t *v) {
+    if (vec_check(v))
+        vec_rev(v->data, v->len);
+}
+
+// Rotates the vector in place so the element at index k becomes the first, 
+// the elements before it moving to the end. Uses three reversals and no 
+// extra memory. Dead slots move with the others. 
+//
+// PARAMS: 
+// v - the vector to rotate
+// k - the index of the new first element, at most the length
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_rotate(vec_t *v, size_t k) {
+    if (!vec_check(v))
+        return VEC_NULL_ERR;
+    if (k > v->len)
+        return VEC_RANGE_ERR;
+    if (k == 0 || k == v->len)
+        return VEC_GOOD;
+
+    vec_rev(v->data, k);
+    vec_rev(v->data + k, v->len - k);
+    vec_rev(v->data, v->len);
+    return VEC_GOOD;
+}
+
+// Swaps the n elements starting at index i with the n elements starting at 
+// index j, in place. The two ranges must not overlap. 
+//
+// PARAMS: 
+// v - the vector to modify
+// i - the start of the first range
+// j - the start of the second range
+// n - the number of elements in each range
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap_ranges(vec_t *v, size_t i, size_t j, size_t n) {
+    if (!vec_check(v))
+        return VEC_NULL_ERR;
+    if (i > v->len || n > v->len - i || j > v->len || n > v->len - j)
+        return VEC_RANGE_ERR;
+    if (n == 0 || i == j)
+        return VEC_GOOD;
+    if ((i < j) ? (j - i < n) : (i - j < n))
+        return VEC_RANGE_ERR;   // the ranges overlap
+
+    void **a = v->data + i, **b = v->data + j;
+    for (size_t k = 0; k < n; k++) {
+        void *swap = a[k];
+        a[k] = b[k];
+        b[k] = swap;
+    }
+    return VEC_GOOD;
+}
+
+// Moves the contents of src into dst in constant time, leaving src empty as 
+// after vec_free. dst is overwritten without being freed, so it must be 
+// uninitialised or freed. A vector on a buffer it does not own has its slots 
+// copied to the heap first. 
+//
+// PARAMS: 
+// dst - the vector to move into
+// src - the vector to move from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_take(vec_t *dst, vec_t *src) {
+    if (dst == NULL || !vec_check(src))
+        return VEC_NULL_ERR;
+    if (dst == src)
+        return VEC_GOOD;
+    if (!vec_own(src))
+        return VEC_ALLOC_ERR;
+
+    *dst = *src;
+    src->data = NULL;
+    src->len = 0;
+    src->slab = NULL;
+    src->ndead = 0;
+    return VEC_GOOD;
+}
+
+// Swaps the contents of two vectors in constant time. A vector on a buffer 
+// it does not own has its slots copied to the heap first, so neither ends 
+// up on storage that belongs to the other. 
+//
+// PARAMS: 
+// a - the first vector
+// b - the second vector
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap(vec_t *a, vec_t *b) {
+    if (!vec_check(a) || !vec_check(b))
+        return VEC_NULL_ERR;
+    if (!vec_own(a) || !vec_own(b))
+        return VEC_ALLOC_ERR;
+
+    vec_t swap = *a;
+    *a = *b;
+    *b = swap;
+    return VEC_GOOD;
+}
+
+// Clears the specified vector, freeing all elements. 
+//
+// PARAMS: 
+// v - the vector to clear
+void vec_clear(vec_t *v) {
+    if (vec_check(v)) {
+        if (v->slabsz != 0)
+            vec_slab_release(v, true);
+        else
+            for (size_t i = 0; i < v->len; i++)
+                vec_free_elem(v, v->data[i]);
+        v->len = 0;
+        v->ndead = 0;
+    }
+}
+
+// Frees the internal buffer in the specified vector. 
+//
+// PARAMS: 
+// v - the vector to free
+void vec_free(vec_t *v) {
+    if (vec_check(v)) {
+        if (v->slabsz != 0)
+            vec_slab_release(v, false);
+        else
+            for (size_t i = 0; i < v->len; i++)
+                vec_free_elem(v, v->data[i]);
+        if (!v->inl)
+            vec_mem_free(v->alloc, v->data);
+        v->data = NULL;
+    }
+}
+
+// Gets the instrumentation counters of the specified vector, or the global 
+// counters summed over every vector if v is NULL. The counters are only 
+// recorded when the library is built with VEC_STATS defined, they read as 
+// zero otherwise. 
+//
+// PARAMS: 
+// v   - the vector, NULL for the global counters
+// out - where to store the counters
+void vec_stats_get(const vec_t *v, vec_stats_t *out) {
+    if (out == NULL)
+        return;
+    memset(out, 0, sizeof *out);
+#ifdef VEC_STATS
+    if (v != NULL)
+        *out = v->stats;
+    else
+        vec_stat_load(out);
+#else
+    (void)v;
+#endif
+}
+
+// Resets the instrumentation counters of the specified vector, or the global 
+// counters if v is NULL. The peak capacity of a vector restarts from its 
+// current capacity, the global peak restarts from zero and rises again as 
+// vectors grow. 
+//
+// PARAMS: 
+// v - the vector, NULL for the global counters
+void vec_stats_reset(vec_t *v) {
+#ifdef VEC_STATS
+    if (v != NULL)
+        vec_stat_init(&v->stats, v->max);
+    else
+        vec_stat_clear();
+#else
+    (void)v;
+#endif
+}
+
+// Initialises the specified by-value vector. Every element will take n bytes 
+// in a single contiguous buffer. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized(vec_sized_t *v, size_t n) {
+    return vec_setup_sized(v, n, DEF_MAX, NULL, NULL);
+}
+
+// Initialises the specified by-value vector with an allocator. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each element
+// a - the allocator, NULL for malloc, realloc and free
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized_alloc(vec_sized_t *v, size_t n, const vec_alloc_t *a) {
+    return vec_setup_sized(v, n, DEF_MAX, a, NULL);
+}
+
+// Initialises the specified by-value vector with room for exactly cap 
+// elements. 
+//
+// PARAMS: 
+// v   - the vector to initialise
+// n   - the size of each element
+// cap - number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized_cap(vec_sized_t *v, size_t n, size_t cap) {
+    return vec_setup_sized(v, n, cap, NULL, NULL);
+}
+
+// Initialises the specified by-value vector on top of a buffer of cap 
+// elements that is not owned by the vector. No allocation is made until the 
+// vector outgrows the buffer, its elements are then copied to the heap. The 
+// buffer is never resized or freed and must outlive the vector. 
+//
+// PARAMS: 
+// v   - the vector to initialise
+// n   - the size of each element
+// buf - the buffer, at least n * cap bytes
+// cap - the number of elements in the buffer
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized_buf(vec_sized_t *v, size_t n, void *buf, size_t cap) {
+    if (buf == NULL)
+        return VEC_NULL_ERR;
+    if (cap == 0)
+        return VEC_RANGE_ERR;
+    return vec_setup_sized(v, n, cap, NULL, buf);
+}
+
+// Reserves n elements in the specified by-value vector. The buffer is 
+// resized to exactly n elements, nothing is done if it can already hold n 
+// elements. 
+//
+// PARAMS: 
+// v - the vector to reserve
+// n - number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_reserve_sized(vec_sized_t *v, size_t n) {
+    if (!vec_check_sized(v))
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (n <= v->max)
+        return VEC_GOOD;
+    if (n > SIZE_MAX / v->size)
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_ALLOC_ERR;
+    unsigned char *res = vec_mem_regrow(v->alloc, v->data, v->len * v->size, 
+            n * v->size, &v->inl);
+    if (res != NULL) {
+        ret = VEC_GOOD;
+        v->max = n;
+        v->data = res;
+        STAT_GROW(v, n * v->size);
+    }
+    return ret;
+}
+
+// Shrinks the buffer of the specified by-value vector to its current length. 
+// A vector still on a buffer it does not own is left as is. 
+//
+// PARAMS: 
+// v - the vector to shrink
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_shrink_to_fit_sized(vec_sized_t *v) {
+    if (!vec_check_sized(v))
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+
+    size_t n = (v->len == 0) ? 1 : v->len;  // keep the buffer valid
+    if (n == v->max || v->inl)
+        return VEC_GOOD;
+
+    int ret = VEC_ALLOC_ERR;
+    unsigned char *res = vec_mem_resize(v->alloc, v->data, n * v->size);
+    if (res != NULL) {
+        ret = VEC_GOOD;
+        v->max = n;
+        v->data = res;
+        STAT_ADD(v, realloc_bytes, n * v->size);
+    }
+    return ret;
+}
+
+// Sets the growth policy of the specified by-value vector. 
+//
+// PARAMS: 
+// v    - the vector to set
+// grow - VEC_GROW_DOUBLE, VEC_GROW_HALF or VEC_GROW_STEP
+// step - number of elements to grow by for VEC_GROW_STEP
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_set_growth_sized(vec_sized_t *v, int grow, size_t step) {
+    if (v == NULL)
+        return VEC_NULL_ERR;
+    if (grow < VEC_GROW_DOUBLE || grow > VEC_GROW_STEP)
+        return VEC_RANGE_ERR;
+    if (grow == VEC_GROW_STEP && step == 0)
+        return VEC_RANGE_ERR;
+
+    v->grow = grow;
+    v->step = step;
+    return VEC_GOOD;
+}
+
+// Sorts the specified by-value vector using the comparison function. The 
+// comparison function receives pointers to the elements themselves. 
+//
+// PARAMS: 
+// v   - the vector to sort
+// cmp - the comparison function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_sized(vec_sized_t *v, int (*cmp)(const void *, const void *)) {
+    if (!vec_check_sized(v) || cmp == NULL)
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (v->len != 0)
+        qsort(v->data, v->len, v->size, cmp);
+    return VEC_GOOD;
+}
+
+// Adds a new element into the specified by-value vector. The new element will 
+// be copied into the buffer. 
+//
+// PARAMS: 
+// v - the vector to add the element
+// d - the element to add
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_sized(vec_sized_t *v, const void *d) {
+    if (!vec_check_sized(v) || d == NULL)
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (!vec_fix_sized(v))
+        return VEC_ALLOC_ERR;
+
+    memcpy(v->data + v->len * v->size, d, v->size);
+    v->len++;
+    return VEC_GOOD;
+}
+
+// Adds count elements from a contiguous array into the specified by-value 
+// vector with a single copy. 
+//
+// PARAMS: 
+// v     - the vector to add the elements
+// src   - the array of elements
+// count - the number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_many_sized(vec_sized_t *v, const void *src, size_t count) {
+    if (!vec_check_sized(v) || src == NULL)
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (!vec_fit_sized(v, count))
+        return VEC_ALLOC_ERR;
+
+    if (count != 0)
+        memcpy(v->data + v->len * v->size, src, count * v->size);
+    v->len += count;
+    return VEC_GOOD;
+}
+
+// Appends every element in src to dst with a single copy. Both vectors must 
+// have the same element size. 
+//
+// PARAMS: 
+// dst - the vector to append to
+// src - the vector to copy from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_extend_sized(vec_sized_t *dst, const vec_sized_t *src) {
+    if (!vec_check_sized(dst) || !vec_check_sized(src))
+        return VEC_NULL_ERR;
+    if (dst->rdonly)
+        return VEC_RDONLY_ERR;
+    if (dst->size != src->size)
+        return VEC_RANGE_ERR;
+
+    size_t count = src->len;    // dst may be src
+    if (!vec_fit_sized(dst, count))
+        return VEC_ALLOC_ERR;
+
+    if (count != 0)
+        memcpy(dst->data + dst->len * dst->size, src->data, count * dst->size);
+    dst->len += count;
+    return VEC_GOOD;
+}
+
+// Inserts a new element into the specified by-value vector. The new element 
+// will be copied into the buffer. 
+//
+// PARAMS: 
+// v - the vector to insert the element
+// d - the element to insert
+// i - the index to insert to
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_sized(vec_sized_t *v, const void *d, size_t i) {
+    if (!vec_check_sized(v) || d == NULL)
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (i >= v->len)
+        return vec_add_sized(v, d);     // add to last if out of range
+    if (!vec_fix_sized(v))
+        return VEC_ALLOC_ERR;
+
+    unsigned char *pos = v->data + i * v->size;
+    memmove(pos + v->size, pos, (v->len - i) * v->size);
+    STAT_ADD(v, move_bytes, (v->len - i) * v->size);
+    memcpy(pos, d, v->size);
+    v->len++;
+    return VEC_GOOD;
+}
+
+// Inserts count elements from a contiguous array into the specified by-value 
+// vector. The tail is shifted once and the elements are copied in one block. 
+//
+// PARAMS: 
+// v     - the vector to insert the elements
+// i     - the index to insert to
+// src   - the array of elements
+// count - the number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_range_sized(vec_sized_t *v, size_t i, const void *src, 
+        size_t count) {
+    if (!vec_check_sized(v) || src == NULL)
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (i >= v->len)    // add to last if out of range
+        return vec_add_many_sized(v, src, count);
+    if (count == 0)
+        return VEC_GOOD;
+    if (!vec_fit_sized(v, count))
+        return VEC_ALLOC_ERR;
+
+    unsigned char *pos = v->data + i * v->size;
+    memmove(pos + count * v->size, pos, (v->len - i) * v->size);
+    STAT_ADD(v, move_bytes, (v->len - i) * v->size);
+    memcpy(pos, src, count * v->size);
+    v->len += count;
+    return VEC_GOOD;
+}
+
+// Returns the element in the by-value vector specified by the index. The 
+// returned pointer is invalidated by any call that grows the vector. 
+//
+// PARAMS: 
+// v - the vector to get the element
+// i - the index of the element
+//
+// RET: 
+// The element inside the buffer, or NULL on error. 
+void *vec_get_sized(const vec_sized_t *v, size_t i) {
+    if (!vec_check_sized(v) || i >= v->len)
+        return NULL;
+    return v->data + i * v->size;
+}
+
+// Deletes an element in the by-value vector specified by the index. 
+//
+// PARAMS: 
+// v   - the vector to delete the element
+// i   - the index of the element
+// out - where to copy the deleted element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_del_sized(vec_sized_t *v, size_t i, void *out) {
+    if (!vec_check_sized(v))
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (v->len == 0)
+        return VEC_RANGE_ERR;
+
+    i = (i >= v->len) ? (v->len - 1) : i;   // remove last if out of range
+    unsigned char *pos = v->data + i * v->size;
+    if (out != NULL)
+        memcpy(out, pos, v->size);
+    memmove(pos, pos + v->size, (v->len - i - 1) * v->size);
+    STAT_ADD(v, move_bytes, (v->len - i - 1) * v->size);
+    v->len--;
+    return VEC_GOOD;
+}
+
+// Removes an element in the by-value vector specified by the index by moving 
+// the last element into its slot. Runs in constant time but does not keep 
+// the order. 
+//
+// PARAMS: 
+// v   - the vector to remove the element
+// i   - the index of the element
+// out - where to copy the removed element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap_remove_sized(vec_sized_t *v, size_t i, void *out) {
+    if (!vec_check_sized(v))
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (i >= v->len)
+        return VEC_RANGE_ERR;
+
+    unsigned char *pos = v->data + i * v->size;
+    unsigned char *last = v->data + --v->len * v->size;
+    if (out != NULL)
+        memcpy(out, pos, v->size);
+    if (pos != last)
+        memcpy(pos, last, v->size);
+    return VEC_GOOD;
+}
+
+// Removes the last element in the specified by-value vector. 
+//
+// PARAMS: 
+// v   - the vector to remove the element
+// out - where to copy the removed element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_pop_sized(vec_sized_t *v, void *out) {
+    if (!vec_check_sized(v))
+        return VEC_NULL_ERR;
+    if (v->rdonly)
+        return VEC_RDONLY_ERR;
+    if (v->len == 0)
+        return VEC_RANGE_ERR;
+
+    v->len--;
+    if (out != NULL)
+        memcpy(out, v->data + v->len * v->size, v->size);
+    return VEC_GOOD;
+}
+
+// Deletes a range of elements in the specified by-value vector. 
+//
+// PARAMS: 
+// v - the vector to delete the elements
+// i - the starting index to delete
+// n - the number of elements to delete
+void vec_delrange_sized(vec_sized_t *v, size_t i, size_t n) {
+    if (!vec_check_sized(v) || v->rdonly || n == 0 || v->len == 0)
+        return;
+
+    // fix i and n if they are out of range
+    i = (i >= v->len) ? (v->len - 1) : i;
+    n = (n > v->len - i) ? (v->len - i) : n;
+
+    size_t left = v->len - (i + n);
+    if (left != 0) {
+        unsigned char *pos = v->data + i * v->size;
+        memmove(pos, pos + n * v->size, left * v->size);
+        STAT_ADD(v, move_bytes, left * v->size);
+    }
+    v->len -= n;
+}
+
+// Keeps only the elements accepted by the predicate. The order of the kept 
+// elements is preserved and the vector is walked once. 
+//
+// PARAMS: 
+// v    - the vector to filter
+// keep - the predicate, receives an element and the context
+// ctx  - the context passed to the predicate
+//
+// RET: 
+// The number of elements removed. 
+size_t vec_retain_sized(vec_sized_t *v, bool (*keep)(const void *, void *), 
+        void *ctx) {
+    if (!vec_check_sized(v) || v->rdonly || keep == NULL)
+        return 0;
+
+    size_t w = 0;
+    for (size_t r = 0; r < v->len; r++) {
+        unsigned char *elem = v->data + r * v->size;
+        if (!keep(elem, ctx))
+            continue;
+        if (w != r)
+            memcpy(v->data + w * v->size, elem, v->size);
+        w++;
+    }
+
+    size_t ret = v->len - w;
+    v->len = w;
+    return ret;
+}
+
+// Moves the contents of src into dst in constant time, leaving src empty as 
+// after vec_free_sized. dst is overwritten without being freed, so it must 
+// be uninitialised or freed. A vector on a buffer it does not own has its 
+// elements copied to the heap first. 
+//
+// PARAMS: 
+// dst - the by-value vector to move into
+// src - the by-value vector to move from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_take_sized(vec_sized_t *dst, vec_sized_t *src) {
+    if (dst == NULL || !vec_check_sized(src))
+        return VEC_NULL_ERR;
+    if (dst == src)
+        return VEC_GOOD;
+    if (!vec_own_sized(src))
+        return VEC_ALLOC_ERR;
+
+    *dst = *src;
+    src->data = NULL;
+    src->len = 0;
+    return VEC_GOOD;
+}
+
+// Swaps the contents of two by-value vectors in constant time. A vector on a 
+// buffer it does not own has its elements copied to the heap first. 
+//
+// PARAMS: 
+// a - the first by-value vector
+// b - the second by-value vector
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap_sized(vec_sized_t *a, vec_sized_t *b) {
+    if (!vec_check_sized(a) || !vec_check_sized(b))
+        return VEC_NULL_ERR;
+    if (!vec_own_sized(a) || !vec_own_sized(b))
+        return VEC_ALLOC_ERR;
+
+    vec_sized_t swap = *a;
+    *a = *b;
+    *b = swap;
+    return VEC_GOOD;
+}
+
+// Clears the specified by-value vector. 
+//
+// PARAMS: 
+// v - the vector to clear
+void vec_clear_sized(vec_sized_t *v) {
+    if (vec_check_sized(v) && !v->rdonly)
+        v->len = 0;
+}
+
+// Frees the internal buffer in the specified by-value vector. 
+//
+// PARAMS: 
+// v - the vector to free
+void vec_free_sized(vec_sized_t *v) {
+    if (vec_check_sized(v)) {
+        if (!v->inl)
+            vec_mem_free(v->alloc, v->data);
+        v->data = NULL;
+        v->len = 0;
+    }
+}
+
+// Gets the instrumentation counters of the specified by-value vector, or the 
+// global counters if v is NULL, see vec_stats_get. 
+//
+// PARAMS: 
+// v   - the by-value vector, NULL for the global counters
+// out - where to store the counters
+void vec_stats_get_sized(const vec_sized_t *v, vec_stats_t *out) {
+    if (out == NULL)
+        return;
+    memset(out, 0, sizeof *out);
+#ifdef VEC_STATS
+    if (v != NULL)
+        *out = v->stats;
+    else
+        vec_stat_load(out);
+#else
+    (void)v;
+#endif
+}
+
+// Resets the instrumentation counters of the specified by-value vector, or 
+// the global counters if v is NULL. The peak capacity of a vector restarts 
+// from its current capacity, the global peak restarts from zero and rises 
+// again as vectors grow. 
+//
+// PARAMS: 
+// v - the by-value vector, NULL for the global counters
+void vec_stats_reset_sized(vec_sized_t *v) {
+#ifdef VEC_STATS
+    if (v != NULL)
+        vec_stat_init(&v->stats, v->max);
+    else
+        vec_stat_clear();
+#else
+    (void)v;
+#endif
+}
+
+// Fixes the buffer of the vector, reallocates if needed. 
+//
+// PARAMS: 
+// v - the vector to fix
+//
+// RET: 
+// True if the vector has enough storage for one more element, false 
+// otherwise. 
+static _Bool vec_fix(vec_t *v) {
+    return vec_fit(v, 1);
+}
+
+// Fits n more elements into the buffer of the vector, reallocates at most 
+// once if needed. 
+//
+// PARAMS: 
+// v - the vector to fit
+// n - the number of new elements
+//
+// RET: 
+// True if the vector has enough storage for n more elements, false 
+// otherwise. 
+static _Bool vec_fit(vec_t *v, size_t n) {
+    if (v->max - v->len >= n)
+        return true;    // space enough
+
+    size_t max = vec_grow_max(v->max, v->len, n, sizeof *v->data, v->grow, 
+            v->step);
+    if (max == 0)
+        return false;
+
+    _Bool ret = false;
+    void **temp = vec_mem_regrow(v->alloc, v->data, v->len * (sizeof *temp), 
+            max * (sizeof *temp), &v->inl);
+    if (temp != NULL) {
+        ret = true;
+        v->max = max;
+        v->data = temp;
+        STAT_GROW(v, max * (sizeof *temp));
+    }
+    return ret;
+}
+
+// Insertion sort of n element pointers. 
+//
+// PARAMS: 
+// a   - the element pointers to sort
+// n   - the number of element pointers
+// cmp - the comparison function
+static void vec_isort(void **a, size_t n, 
+        int (*cmp)(const void *, const void *)) {
+    for (size_t i = 1; i < n; i++) {
+        void *x = a[i];
+        size_t j = i;
+        for (; j > 0 && cmp(&x, &a[j - 1]) < 0; j--)
+            a[j] = a[j - 1];
+        a[j] = x;
+    }
+}
+
+// Sifts an element pointer down a max-heap. 
+//
+// PARAMS: 
+// a   - the heap
+// i   - the index to sift down
+// n   - the size of the heap
+// cmp - the comparison function
+static void vec_sift(void **a, size_t i, size_t n, 
+        int (*cmp)(const void *, const void *)) {
+    void *x = a[i];
+    for (size_t c = 2 * i + 1; c < n; c = 2 * i + 1) {
+        if (c + 1 < n && cmp(&a[c], &a[c + 1]) < 0)
+            c++;
+        if (cmp(&x, &a[c]) >= 0)
+            break;
+        a[i] = a[c];
+        i = c;
+    }
+    a[i] = x;
+}
+
+// Partitions n element pointers around the median of the first, middle and 
+// last ones. 
+//
+// PARAMS: 
+// a   - the element pointers to partition, at least three
+// n   - the number of element pointers
+// cmp - the comparison function
+//
+// RET: 
+// The split, no element before it is greater than any element from it on. 
+static size_t vec_partition(void **a, size_t n, 
+        int (*cmp)(const void *, const void *)) {
+    size_t m = n / 2;
+    void *x;
+    if (cmp(&a[m], &a[0]) < 0) { x = a[m]; a[m] = a[0]; a[0] = x; }
+    if (cmp(&a[n - 1], &a[m]) < 0) { x = a[m]; a[m] = a[n - 1]; a[n - 1] = x; }
+    if (cmp(&a[m], &a[0]) < 0) { x = a[m]; a[m] = a[0]; a[0] = x; }
+
+    void *p = a[m];
+    size_t i = 0, j = n - 1;
+    for (;;) {
+        while (cmp(&a[i], &p) < 0) {
+            vec_prefetch(a, i, n);
+            i++;
+        }
+        while (cmp(&p, &a[j]) < 0) {
+            if (j + 1 > VEC_PREFETCH_DIST)
+                VEC_PREFETCH(a[j - VEC_PREFETCH_DIST]);
+            j--;
+        }
+        if (i >= j)
+            break;
+        x = a[i];
+        a[i++] = a[j];
+        a[j--] = x;
+    }
+    return j + 1;
+}
+
+// Introsort of n element pointers, quicksort falling back to heapsort after 
+// too many bad pivots and to insertion sort on short ranges. 
+//
+// PARAMS: 
+// a     - the element pointers to sort
+// n     - the number of element pointers
+// depth - the bad pivots allowed before falling back to heapsort
+// cmp   - the comparison function
+static void vec_introsort(void **a, size_t n, size_t depth, 
+        int (*cmp)(const void *, const void *)) {
+    while (n > ISORT_MAX) {
+        if (depth-- == 0) {     // too many bad pivots
+            for (size_t i = n / 2; i > 0; i--)
+                vec_sift(a, i - 1, n, cmp);
+            for (size_t i = n - 1; i > 0; i--) {
+                void *swap = a[0];
+                a[0] = a[i];
+                a[i] = swap;
+                vec_sift(a, 0, i, cmp);
+            }
+            return;
+        }
+
+        // recurse into the smaller half, loop on the larger
+        size_t left = vec_partition(a, n, cmp);
+        if (left < n - left) {
+            vec_introsort(a, left, depth, cmp);
+            a += left;
+            n -= left;
+        } else {
+            vec_introsort(a + left, n - left, depth, cmp);
+            n = left;
+        }
+    }
+    vec_isort(a, n, cmp);
+}
+
+// Copies every live element of a vector without an arena to new allocations 
+// made in index order, then frees the old copies. Nothing is changed on 
+// error. 
+//
+// PARAMS: 
+// v    - the vector to relocate
+// size - returns the size in bytes of an element, receives the context
+// ctx  - the context passed to the size function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int vec_relocate_heap(vec_t *v, 
+        size_t (*size)(const void *, void *), void *ctx) {
+    void **tmp = vec_mem_alloc(v->alloc, 
+            ((v->len == 0) ? 1 : v->len) * sizeof *tmp);
+    if (tmp == NULL)
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_GOOD;
+    size_t i = 0;
+    for (; i < v->len && ret == VEC_GOOD; i++) {
+        tmp[i] = NULL;
+        if (v->data[i] == NULL)
+            continue;   // dead slot
+        vec_prefetch(v->data, i, v->len);
+        size_t n = size(v->data[i], ctx);
+        if (n == 0)
+            ret = VEC_RANGE_ERR;
+        else if ((tmp[i] = vec_new_elem(v, v->data[i], n)) == NULL)
+            ret = VEC_ALLOC_ERR;
+    }
+
+    // keep the new copies on success, drop them on error
+    for (size_t j = 0; j < i; j++) {
+        if (ret == VEC_GOOD) {
+            vec_free_elem(v, v->data[j]);
+            v->data[j] = tmp[j];
+        } else {
+            vec_free_elem(v, tmp[j]);
+        }
+    }
+    vec_mem_free(v->alloc, tmp);
+    return ret;
+}
+
+// Reverses n element pointers in place. The ends are swapped REV_BLOCK 
+// pointers at a time through fixed size blocks, which compilers turn into 
+// vector loads, shuffles and stores. 
+//
+// PARAMS: 
+// a - the element pointers to reverse
+// n - the number of element pointers
+static void vec_rev(void **a, size_t n) {
+    size_t i = 0, j = n;
+    while (j - i >= 2 * REV_BLOCK) {
+        void *lo[REV_BLOCK], *hi[REV_BLOCK];
+        memcpy(lo, a + i, sizeof lo);
+        memcpy(hi, a + j - REV_BLOCK, sizeof hi);
+        for (size_t k = 0; k < REV_BLOCK; k++) {
+            a[i + k] = hi[REV_BLOCK - 1 - k];
+            a[j - 1 - k] = lo[k];
+        }
+        i += REV_BLOCK;
+        j -= REV_BLOCK;
+    }
+    while (j - i > 1) {     // fewer than two blocks left in the middle
+        void *swap = a[i];
+        a[i++] = a[--j];
+        a[j] = swap;
+    }
+}
+
+// Prefetches the element VEC_PREFETCH_DIST slots after index i. 
+//
+// PARAMS: 
+// a - the element pointers
+// i - the current index
+// n - the number of element pointers
+static inline void vec_prefetch(void *const *a, size_t i, size_t n) {
+    if (n - i > VEC_PREFETCH_DIST)
+        VEC_PREFETCH(a[i + VEC_PREFETCH_DIST]);
+}
+
+// Calculates the new maximum length of a buffer that needs n more elements, 
+// growing the current maximum by the policy until they fit. 
+//
+// PARAMS: 
+// max  - the current maximum length
+// len  - the current length
+// n    - the number of new elements
+// size - the size of each element in the buffer
+// grow - the growth policy
+// step - the growth step for VEC_GROW_STEP
+//
+// RET: 
+// The new maximum length, or zero on overflow. 
+static size_t vec_grow_max(size_t max, size_t len, size_t n, size_t size, 
+        int grow, size_t step) {
+    size_t lim = SIZE_MAX / size;
+    if (n > lim - len)
+        return 0;
+
+    size_t need = len + n;
+    if (grow == VEC_GROW_STEP) {
+        size_t steps = (need - max + step - 1) / step;
+        return (steps > (lim - max) / step) ? need : max + steps * step;
+    }
+
+    max = (max == 0) ? 1 : max;
+    while (max < need) {
+        size_t inc = (grow == VEC_GROW_HALF) ? (max / 2 + 1) : max;
+        max = (inc > lim - max) ? need : max + inc;
+    }
+    return max;
+}
+
+// Sets up the specified vector with room for exactly cap elements. 
+//
+// PARAMS: 
+// v   - the vector to set up
+// cap - number of elements
+// a   - the allocator, NULL for malloc, realloc and free
+// buf - a buffer of cap slots not owned by the vector, NULL to allocate
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int vec_setup(vec_t *v, size_t cap, const vec_alloc_t *a, void **buf) {
+    if (v == NULL)
+        return VEC_NULL_ERR;
+
+    cap = (cap == 0) ? 1 : cap;     // keep the buffer valid
+    if (cap > SIZE_MAX / sizeof(void *))
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_GOOD;
+    v->len = 0;
+    v->max = cap;
+    v->slab = NULL;
+    v->slabsz = 0;
+    v->alloc = (a == NULL) ? &vec_libc : a;
+    v->grow = VEC_GROW_DOUBLE;
+    v->step = 0;
+    v->ndead = 0;
+    v->tomb = 0;
+    v->inl = (buf != NULL);
+    v->data = v->inl ? buf : vec_mem_alloc(v->alloc, cap * sizeof(void *));
+    if (v->data == NULL)
+        ret = VEC_ALLOC_ERR;
+    STAT_INIT(v);
+    return ret;
+}
+
+// Checks whether the vector is valid. 
+//
+// PARAMS: 
+// v - the vector to check
+//
+// RET: 
+// True if the vector is in valid state, false otherwise. 
+static inline _Bool vec_check(vec_t *v) {
+    return (v != NULL && v->data != NULL);
+}
+
+// Returns a copy of the specified element. 
+//
+// PARAMS: 
+// v - the vector owning the copy
+// d - the element to copy
+// n - the size of the element
+static void *vec_new_elem(vec_t *v, const void *d, size_t n) {
+    if (d == NULL || n == 0)
+        return NULL;
+
+    void *ret = (v->slabsz != 0) ? vec_slab_alloc(v, n)
+                                 : vec_mem_alloc(v->alloc, n);
+    if (ret != NULL) {
+        memcpy(ret, d, n);
+        STAT_ADD(v, allocs, 1);
+    }
+    return ret;
+}
+
+// Frees an element copy made by vec_new_elem. Arena copies are only released 
+// with their slab. 
+//
+// PARAMS: 
+// v - the vector owning the copy
+// e - the element to free
+static inline void vec_free_elem(vec_t *v, void *e) {
+    if (v->slabsz == 0 && e != NULL) {
+        vec_mem_free(v->alloc, e);
+        STAT_ADD(v, frees, 1);
+    }
+}
+
+// Carves n bytes from the arena of the vector, adding a new slab if the 
+// current one is full. 
+//
+// PARAMS: 
+// v - the vector owning the arena
+// n - the number of bytes
+//
+// RET: 
+// The carved memory, or NULL on error. 
+static void *vec_slab_alloc(vec_t *v, size_t n) {
+    if (n > SIZE_MAX - SLAB_ALIGN - SLAB_HDR)
+        return NULL;    // would wrap once rounded up or given a header
+    n = (n + SLAB_ALIGN - 1) & ~(size_t)(SLAB_ALIGN - 1);
+    struct vec_slab *s = v->slab;
+    if (s == NULL || s->cap - s->used < n) {
+        size_t cap = (n > v->slabsz) ? n : v->slabsz;
+        if (cap > SIZE_MAX - SLAB_HDR)
+            return NULL;
+        s = vec_mem_alloc(v->alloc, SLAB_HDR + cap);
+        if (s == NULL)
+            return NULL;
+        s->used = 0;
+        s->cap = cap;
+        STAT_SLAB(s, 0);
+        s->next = v->slab;
+        v->slab = s;
+    }
+
+    void *ret = (unsigned char *)s + SLAB_HDR + s->used;
+    s->used += n;
+    STAT_CARVE(s);
+    return ret;
+}
+
+// Releases the arena of the vector, counting the copies of every slab reset 
+// or freed as freed. 
+//
+// PARAMS: 
+// v    - the vector owning the arena
+// keep - whether to keep the newest slab for reuse
+static void vec_slab_release(vec_t *v, _Bool keep) {
+    struct vec_slab *s = v->slab;
+    if (keep && s != NULL) {
+        STAT_DROP(v, s);
+        STAT_SLAB(s, 0);
+        s->used = 0;
+        s = s->next;
+        v->slab->next = NULL;
+    } else {
+        v->slab = NULL;
+    }
+
+    while (s != NULL) {
+        struct vec_slab *next = s->next;
+        STAT_DROP(v, s);
+        vec_mem_free(v->alloc, s);
+        s = next;
+    }
+}
+
+
+// Fixes the buffer of the by-value vector, reallocates if needed. 
+//
+// PARAMS: 
+// v - the vector to fix
+//
+// RET: 
+// True if the vector has enough storage for one more element, false 
+// otherwise. 
+static _Bool vec_fix_sized(vec_sized_t *v) {
+    return vec_fit_sized(v, 1);
+}
+
+// Fits n more elements into the buffer of the by-value vector, reallocates 
+// at most once if needed. 
+//
+// PARAMS: 
+// v - the vector to fit
+// n - the number of new elements
+//
+// RET: 
+// True if the vector has enough storage for n more elements, false 
+// otherwise. 
+static _Bool vec_fit_sized(vec_sized_t *v, size_t n) {
+    if (v->max - v->len >= n)
+        return true;    // space enough
+
+    size_t max = vec_grow_max(v->max, v->len, n, v->size, v->grow, v->step);
+    if (max == 0)
+        return false;
+
+    _Bool ret = false;
+    unsigned char *temp = vec_mem_regrow(v->alloc, v->data, v->len * v->size, 
+            max * v->size, &v->inl);
+    if (temp != NULL) {
+        ret = true;
+        v->max = max;
+        v->data = temp;
+        STAT_GROW(v, max * v->size);
+    }
+    return ret;
+}
+
+// Sets up the specified by-value vector with room for exactly cap elements. 
+//
+// PARAMS: 
+// v   - the vector to set up
+// n   - the size of each element
+// cap - number of elements
+// a   - the allocator, NULL for malloc, realloc and free
+// buf - a buffer of cap elements not owned by the vector, NULL to allocate
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static int vec_setup_sized(vec_sized_t *v, size_t n, size_t cap, 
+        const vec_alloc_t *a, void *buf) {
+    if (v == NULL)
+        return VEC_NULL_ERR;
+    if (n == 0)
+        return VEC_RANGE_ERR;
+
+    cap = (cap == 0) ? 1 : cap;     // keep the buffer valid
+    if (cap > SIZE_MAX / n)
+        return VEC_ALLOC_ERR;
+
+    int ret = VEC_GOOD;
+    v->len = 0;
+    v->max = cap;
+    v->size = n;
+    v->alloc = (a == NULL) ? &vec_libc : a;
+    v->grow = VEC_GROW_DOUBLE;
+    v->step = 0;
+    v->rdonly = false;
+    v->inl = (buf != NULL);
+    v->data = v->inl ? buf : vec_mem_alloc(v->alloc, cap * n);
+    if (v->data == NULL)
+        ret = VEC_ALLOC_ERR;
+    STAT_INIT(v);
+    return ret;
+}
+
+// Checks whether the by-value vector is valid. 
+//
+// PARAMS: 
+// v - the vector to check
+//
+// RET: 
+// True if the vector is in valid state, false otherwise. 
+static inline _Bool vec_check_sized(const vec_sized_t *v) {
+    return (v != NULL && v->data != NULL);
+}
+
+// Moves the slots of the vector to the heap if it does not own its buffer. 
+//
+// PARAMS: 
+// v - the vector to move
+//
+// RET: 
+// True if the vector owns its buffer, false on allocation failure. 
+static _Bool vec_own(vec_t *v) {
+    if (!v->inl)
+        return true;
+
+    void **res = vec_mem_regrow(v->alloc, v->data, v->len * (sizeof *res), 
+            v->max * (sizeof *res), &v->inl);
+    if (res != NULL)
+        v->data = res;
+    return res != NULL;
+}
+
+// Moves the elements of the by-value vector to the heap if it does not own 
+// its buffer. 
+//
+// PARAMS: 
+// v - the vector to move
+//
+// RET: 
+// True if the vector owns its buffer, false on allocation failure. 
+static _Bool vec_own_sized(vec_sized_t *v) {
+    if (!v->inl)
+        return true;
+
+    unsigned char *res = vec_mem_regrow(v->alloc, v->data, v->len * v->size, 
+            v->max * v->size, &v->inl);
+    if (res != NULL)
+        v->data = res;
+    return res != NULL;
+}
+
+// Allocates n bytes using malloc. 
+//
+// PARAMS: 
+// ctx - unused
+// n   - the number of bytes
+static void *vec_libc_alloc(void *ctx, size_t n) {
+    (void)ctx;
+    return malloc(n);
+}
+
+// Resizes the memory using realloc. 
+//
+// PARAMS: 
+// ctx - unused
+// p   - the memory to resize
+// n   - the new number of bytes
+static void *vec_libc_resize(void *ctx, void *p, size_t n) {
+    (void)ctx;
+    return realloc(p, n);
+}
+
+// Frees the memory using free. 
+//
+// PARAMS: 
+// ctx - unused
+// p   - the memory to free
+static void vec_libc_release(void *ctx, void *p) {
+    (void)ctx;
+    free(p);
+}
+
+// Allocates n bytes using the allocator. 
+//
+// PARAMS: 
+// a - the allocator
+// n - the number of bytes
+static inline void *vec_mem_alloc(const vec_alloc_t *a, size_t n) {
+    return a->alloc(a->ctx, n);
+}
+
+// Resizes the memory using the allocator. 
+//
+// PARAMS: 
+// a - the allocator
+// p - the memory to resize
+// n - the new number of bytes
+static inline void *vec_mem_resize(const vec_alloc_t *a, void *p, size_t n) {
+    return a->resize(a->ctx, p, n);
+}
+
+// Resizes the buffer of a vector using the allocator. A buffer the vector 
+// does not own is left untouched, its first used bytes are copied to a new 
+// allocation which the vector owns from then on. 
+//
+// PARAMS: 
+// a    - the allocator
+// p    - the buffer to resize
+// used - the number of bytes in use
+// n    - the new number of bytes
+// inl  - whether the vector does not own the buffer, cleared once it does
+//
+// RET: 
+// The resized buffer, or NULL on error. 
+static void *vec_mem_regrow(const vec_alloc_t *a, void *p, size_t used, 
+        size_t n, _Bool *inl) {
+    if (!*inl)
+        return vec_mem_resize(a, p, n);
+
+    void *ret = vec_mem_alloc(a, n);
+    if (ret != NULL) {
+        memcpy(ret, p, used);
+        *inl = false;
+    }
+    return ret;
+}
+
+// Frees the memory using the allocator. 
+//
+// PARAMS: 
+// a - the allocator
+// p - the memory to free
+static inline void vec_mem_free(const vec_alloc_t *a, void *p) {
+    a->release(a->ctx, p);
+}
+
+#ifdef VEC_STATS
+// Adds to a counter of a vector and to the matching global counter. 
+//
+// PARAMS: 
+// own - the counter of the vector
+// all - the global counter
+// n   - the amount to add
+static inline void vec_stat_add(size_t *own, size_t *all, size_t n) {
+    *own += n;
+    __atomic_fetch_add(all, n, __ATOMIC_RELAXED);
+}
+
+// Raises the peak capacity of a vector and the global peak capacity. 
+//
+// PARAMS: 
+// s   - the counters of the vector
+// max - the current capacity
+static void vec_stat_peak(vec_stats_t *s, size_t max) {
+    if (max > s->peak)
+        s->peak = max;
+
+    size_t peak = __atomic_load_n(&vec_global.peak, __ATOMIC_RELAXED);
+    while (max > peak && !__atomic_compare_exchange_n(&vec_global.peak, 
+            &peak, max, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+// Records a growth of the buffer of a vector. 
+//
+// PARAMS: 
+// s   - the counters of the vector
+// max - the new capacity
+// n   - the new size of the buffer in bytes
+static void vec_stat_grow(vec_stats_t *s, size_t max, size_t n) {
+    vec_stat_add(&s->grows, &vec_global.grows, 1);
+    vec_stat_add(&s->realloc_bytes, &vec_global.realloc_bytes, n);
+    vec_stat_peak(s, max);
+}
+
+// Zeroes the counters of a vector, the peak starts from its capacity. 
+//
+// PARAMS: 
+// s   - the counters to zero
+// max - the current capacity
+static void vec_stat_init(vec_stats_t *s, size_t max) {
+    memset(s, 0, sizeof *s);
+    vec_stat_peak(s, max);
+}
+
+// Reads the global counters. 
+//
+// PARAMS: 
+// out - where to store the counters
+static void vec_stat_load(vec_stats_t *out) {
+    out->grows = __atomic_load_n(&vec_global.grows, __ATOMIC_RELAXED);
+    out->realloc_bytes = __atomic_load_n(&vec_global.realloc_bytes, 
+            __ATOMIC_RELAXED);
+    out->move_bytes = __atomic_load_n(&vec_global.move_bytes, 
+            __ATOMIC_RELAXED);
+    out->allocs = __atomic_load_n(&vec_global.allocs, __ATOMIC_RELAXED);
+    out->frees = __atomic_load_n(&vec_global.frees, __ATOMIC_RELAXED);
+    out->peak = __atomic_load_n(&vec_global.peak, __ATOMIC_RELAXED);
+}
+
+// Zeroes the global counters. 
+static void vec_stat_clear(void) {
+    __atomic_store_n(&vec_global.grows, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&vec_global.realloc_bytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&vec_global.move_bytes, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&vec_global.allocs, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&vec_global.frees, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&vec_global.peak, 0, __ATOMIC_RELAXED);
+}
+#endif
@@ -10,20 +10,109 @@
 #define VECTOR_H
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
 #define VEC_GOOD 0
 #define VEC_ALLOC_ERR 1
 #define VEC_NULL_ERR 2
 #define VEC_RANGE_ERR 3
+#define VEC_RDONLY_ERR 4
+#define VEC_IO_ERR 5
+
+#define VEC_GROW_DOUBLE 0   // grow by 2x
+#define VEC_GROW_HALF 1     // grow by 1.5x
+#define VEC_GROW_STEP 2     // grow by a fixed number of elements
+
+#define VEC_ARENA_ALIGN 16  // alignment of element copies in an arena
+
+// Elements ahead that the walks and sorts prefetch, zero turns all 
+// prefetching off. Only read when the library is compiled, so set it with 
+// the VEC_PREFETCH_DIST CMake option or -D on the library build, defining it 
+// in code that includes this header has no effect on the library. 
+#ifndef VEC_PREFETCH_DIST
+#define VEC_PREFETCH_DIST 8
+#endif
+
+// Hints that the memory at p will be read soon, no code where the compiler 
+// has no prefetch builtin. 
+#if defined(__GNUC__) && VEC_PREFETCH_DIST > 0
+#define VEC_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define VEC_PREFETCH(p) ((void)sizeof(p))
+#endif
+
+// Instrumentation counters, recorded when built with VEC_STATS. Every 
+// translation unit including this header must agree on VEC_STATS. The 
+// element copies of an arena vector count as freed when their slab is reset 
+// or freed rather than when they are deleted, and the block repacked by 
+// vec_relocate_contiguous counts as a single copy. 
+typedef struct vector_stats_t {
+    size_t grows;           // times the buffer grew
+    size_t realloc_bytes;   // bytes requested by buffer reallocations
+    size_t move_bytes;      // bytes shifted by inserts and deletes
+    size_t allocs;          // element copies allocated
+    size_t frees;           // element copies freed
+    size_t peak;            // largest capacity in elements
+} vec_stats_t;
+
+// Allocator used by a vector for every allocation it makes. 
+typedef struct vector_alloc_t {
+    void *(*alloc)(void *ctx, size_t n);                // allocates n bytes
+    void *(*resize)(void *ctx, void *p, size_t n);      // resizes p to n bytes
+    void (*release)(void *ctx, void *p);                // frees p
+    void *ctx;                                          // user context
+} vec_alloc_t;
+
+// Slab backing the element copies of an arena vector. 
+struct vec_slab;
 
 // The vector. 
 typedef struct vector_t {
     void **data;            // internal data
     size_t len;             // current length
     size_t max;             // maximum length
+    struct vec_slab *slab;  // arena slabs, NULL if not arena backed
+    size_t slabsz;          // arena slab size, zero if not arena backed
+    const vec_alloc_t *alloc;   // allocator
+    int grow;               // growth policy
+    size_t step;            // growth step for VEC_GROW_STEP
+    size_t ndead;           // dead slots left by tombstone deletes
+    unsigned tomb;          // compaction threshold in percent, 0 when off
+    bool inl;               // data is an inline or caller buffer
+#ifdef VEC_STATS
+    vec_stats_t stats;      // instrumentation counters
+#endif
 } vec_t;
 
+// Inline slots of a small vector, may be defined before including this 
+// header. 
+#ifndef VEC_SMALL_MAX
+#define VEC_SMALL_MAX 4
+#endif
+
+// The vector with its first VEC_SMALL_MAX slots stored inline. 
+typedef struct vector_small_t {
+    vec_t v;                // the vector
+    void *buf[VEC_SMALL_MAX];   // inline slots, used until the vector grows
+} vec_small_t;
+
+// The vector storing elements by value in one contiguous buffer. 
+typedef struct vector_sized_t {
+    unsigned char *data;    // internal data
+    size_t len;             // current length
+    size_t max;             // maximum length
+    size_t size;            // size of each element
+    const vec_alloc_t *alloc;   // allocator
+    int grow;               // growth policy
+    size_t step;            // growth step for VEC_GROW_STEP
+    bool rdonly;            // read-only mapping, mutators fail
+    bool inl;               // data is a caller buffer
+#ifdef VEC_STATS
+    vec_stats_t stats;      // instrumentation counters
+#endif
+} vec_sized_t;
+
 // Initialises the specified vector. 
 //
 // PARAMS: 
@@ -33,8 +122,84 @@ typedef struct vector_t {
 // Zero on success, non-zero on error. 
 int vec_init(vec_t *v);
 
+// Initialises the specified vector with room for exactly n elements. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_cap(vec_t *v, size_t n);
+
+// Initialises the specified vector with an arena. Element copies will be 
+// carved from slabs of n bytes, and are released together by vec_clear or 
+// vec_free. Elements returned by vec_del must not be freed by the caller, 
+// they stay valid until the vector is cleared or freed. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each slab, zero for the default
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_arena(vec_t *v, size_t n);
+
+// Initialises the specified vector with an allocator. Elements returned by 
+// vec_del must be freed using the same allocator. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// a - the allocator, NULL for malloc, realloc and free
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_alloc(vec_t *v, const vec_alloc_t *a);
+
+// Initialises the specified vector with an arena and an allocator. Both the 
+// pointer buffer and the slabs will come from the allocator. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each slab, zero for the default
+// a - the allocator, NULL for malloc, realloc and free
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_arena_alloc(vec_t *v, size_t n, const vec_alloc_t *a);
+
+// Initialises the specified vector on top of a buffer of cap slots that is 
+// not owned by the vector, such as a local array. No allocation is made 
+// until the vector outgrows the buffer, its slots are then copied to the 
+// heap. The buffer is never resized or freed and must outlive the vector. 
+//
+// PARAMS: 
+// v   - the vector to initialise
+// buf - the buffer of slots
+// cap - the number of slots in the buffer
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_buf(vec_t *v, void **buf, size_t cap);
+
+// Initialises the specified small vector on its inline slots, creating it 
+// takes no allocation. Pass &s->v to the other functions. The small vector 
+// must not be copied or moved while in use. 
+//
+// PARAMS: 
+// s - the small vector to initialise
+//
+// RET: 
+// Zero on success, non-zero on error. 
+static inline int vec_init_small(vec_small_t *s) {
+    if (s == NULL)
+        return VEC_NULL_ERR;
+    return vec_init_buf(&s->v, s->buf, VEC_SMALL_MAX);
+}
+
 
-// Reserves n elements in the specified vector. 
+// Reserves n elements in the specified vector. The buffer is resized to 
+// exactly n elements, nothing is done if it can already hold n elements. 
 //
 // PARAMS: 
 // v - the vector to reserve
@@ -44,7 +209,76 @@ int vec_init(vec_t *v);
 // Zero on success, non-zero on error. 
 int vec_reserve(vec_t *v, size_t n);
 
-// Sorts the specified vector using the comparison function. 
+// Shrinks the buffer of the specified vector to its current length. A vector 
+// still on a buffer it does not own is left as is. 
+//
+// PARAMS: 
+// v - the vector to shrink
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_shrink_to_fit(vec_t *v);
+
+// Sets the growth policy of the specified vector. 
+//
+// PARAMS: 
+// v    - the vector to set
+// grow - VEC_GROW_DOUBLE, VEC_GROW_HALF or VEC_GROW_STEP
+// step - number of elements to grow by for VEC_GROW_STEP
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_set_growth(vec_t *v, int grow, size_t step);
+
+// Turns tombstone mode on or off for the specified vector. In tombstone mode 
+// vec_del only marks the slot dead by setting it to NULL, so it runs in 
+// constant time and indices keep referring to raw slots. Loops over the 
+// slots must skip NULL ones, vec_foreach and the parallel walks do. Dead 
+// slots are squeezed out by vec_compact, which runs on its own once they 
+// reach pct percent of the length, and before any sort. The binary searches 
+// take a const vector and need it compacted first. 
+//
+// PARAMS: 
+// v   - the vector to set
+// pct - the dead percentage that triggers compaction, zero turns it off
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_set_tombstones(vec_t *v, unsigned pct);
+
+// Removes the dead slots left by tombstone deletes, keeping the order of the 
+// live elements. Indices of the live elements change. 
+//
+// PARAMS: 
+// v - the vector to compact
+//
+// RET: 
+// The number of slots removed. 
+size_t vec_compact(vec_t *v);
+
+// Copies every live element to new memory in index order, so walks and sorts 
+// touch memory sequentially again after heavy churn, then frees the old 
+// copies. An arena vector is repacked into one slab. A vector without an 
+// arena keeps its ownership rules and gets one new allocation per element in 
+// index order, unless arena is true, in which case it is repacked into one 
+// slab and becomes an arena vector as if made by vec_init_arena: elements 
+// returned by vec_del must then not be freed, deleted elements are only 
+// released by vec_clear or vec_free, and vec_add_owned fails. Nothing is 
+// changed on error. 
+//
+// PARAMS: 
+// v     - the vector to relocate
+// size  - returns the size in bytes of an element, receives the context
+// ctx   - the context passed to the size function
+// arena - whether a vector without an arena may become an arena vector
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_relocate_contiguous(vec_t *v, size_t (*size)(const void *, void *), 
+        void *ctx, bool arena);
+
+// Sorts the specified vector using the comparison function. The partitions 
+// prefetch the elements they are about to compare. 
 //
 // PARAMS: 
 // v   - the vector to sort
@@ -54,6 +288,123 @@ int vec_reserve(vec_t *v, size_t n);
 // Zero on success, non-zero on error. 
 int vec_sort(vec_t *v, int (*cmp)(const void *, const void *));
 
+// Partially sorts the vector so the element at index k is the one that would 
+// be there if the vector was sorted, with no greater element before it and 
+// no smaller element after it. Runs in linear time on average. 
+//
+// PARAMS: 
+// v   - the vector to partially sort
+// k   - the index of the element to place
+// cmp - the comparison function, the same as for vec_sort
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_nth_element(vec_t *v, size_t k, 
+        int (*cmp)(const void *, const void *));
+
+// Sorts the k smallest elements of the vector into its first k slots, the 
+// order of the rest is unspecified. Runs in O(n log k) time. 
+//
+// PARAMS: 
+// v   - the vector to partially sort
+// k   - the number of elements to sort
+// cmp - the comparison function, the same as for vec_sort
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_partial_sort(vec_t *v, size_t k, 
+        int (*cmp)(const void *, const void *));
+
+// Sorts the specified vector by an unsigned key extracted once from every 
+// element, using a stable radix sort. Use the vec_key_* functions to map 
+// signed or floating point keys to unsigned ones with the same order. 
+//
+// PARAMS: 
+// v   - the vector to sort
+// key - the key extraction function, receives an element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_by_key(vec_t *v, uint64_t (*key)(const void *));
+
+// Maps a signed key to an unsigned key with the same order. 
+//
+// PARAMS: 
+// x - the signed key
+//
+// RET: 
+// The unsigned key. 
+static inline uint64_t vec_key_i64(int64_t x) {
+    return (uint64_t)x ^ ((uint64_t)1 << 63);
+}
+
+// Maps a floating point key to an unsigned key with the same order. 
+//
+// PARAMS: 
+// x - the floating point key, must not be NaN
+//
+// RET: 
+// The unsigned key. 
+static inline uint64_t vec_key_f64(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof bits);
+    return (bits >> 63) ? ~bits : (bits | ((uint64_t)1 << 63));
+}
+
+// Finds the first element not ordered before the key in a vector sorted by 
+// the comparison function. The comparison function is the same as for 
+// vec_sort, it receives pointers to element pointers. 
+//
+// PARAMS: 
+// v   - the sorted vector to search
+// key - the element to search for
+// cmp - the comparison function
+//
+// RET: 
+// The index of the element, or the length if there is none. 
+size_t vec_lower_bound(const vec_t *v, const void *key, 
+        int (*cmp)(const void *, const void *));
+
+// Finds the first element ordered after the key in a vector sorted by the 
+// comparison function. The comparison function is the same as for vec_sort. 
+//
+// PARAMS: 
+// v   - the sorted vector to search
+// key - the element to search for
+// cmp - the comparison function
+//
+// RET: 
+// The index of the element, or the length if there is none. 
+size_t vec_upper_bound(const vec_t *v, const void *key, 
+        int (*cmp)(const void *, const void *));
+
+// Searches for an element equal to the key in a vector sorted by the 
+// comparison function. The comparison function is the same as for vec_sort. 
+//
+// PARAMS: 
+// v   - the sorted vector to search
+// key - the element to search for
+// cmp - the comparison function
+//
+// RET: 
+// The first equal element, or NULL if there is none. 
+void *vec_bsearch(const vec_t *v, const void *key, 
+        int (*cmp)(const void *, const void *));
+
+// Inserts a new element into a vector sorted by the comparison function, 
+// after any equal elements. The new element will be copied. 
+//
+// PARAMS: 
+// v   - the sorted vector to insert the element
+// d   - the element to insert
+// n   - the size of the element
+// cmp - the comparison function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_sorted(vec_t *v, const void *d, size_t n, 
+        int (*cmp)(const void *, const void *));
+
 // Adds a new element into the specified vector. The new element will be 
 // copied. 
 //
@@ -66,6 +417,45 @@ int vec_sort(vec_t *v, int (*cmp)(const void *, const void *));
 // Zero on success, non-zero on error. 
 int vec_add(vec_t *v, const void *d, size_t n);
 
+// Adds an element allocated by the caller into the specified vector without 
+// copying it. The vector takes ownership and frees the element with its 
+// allocator, so the element must come from that allocator. Arena vectors 
+// cannot adopt elements. 
+//
+// PARAMS: 
+// v - the vector to add the element
+// d - the element to adopt
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_owned(vec_t *v, void *d);
+
+// Adds count elements from a contiguous array into the specified vector. The 
+// buffer grows at most once and every element will be copied. Nothing is 
+// added on error. 
+//
+// PARAMS: 
+// v     - the vector to add the elements
+// src   - the array of elements
+// count - the number of elements
+// n     - the size of each element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_many(vec_t *v, const void *src, size_t count, size_t n);
+
+// Appends copies of every element in src to dst. The buffer grows at most 
+// once. Nothing is added on error. 
+//
+// PARAMS: 
+// dst - the vector to append to
+// src - the vector to copy from
+// n   - the size of each element in src
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_extend(vec_t *dst, const vec_t *src, size_t n);
+
 // Inserts a new element into the specified vector. The new element will be 
 // copied. 
 //
@@ -79,7 +469,35 @@ int vec_add(vec_t *v, const void *d, size_t n);
 // Zero on success, non-zero on error. 
 int vec_ins(vec_t *v, const void *d, size_t n, size_t i);
 
-// Deletes an element in the vector specified by the index. 
+// Inserts an element allocated by the caller into the specified vector 
+// without copying it, ownership is taken as in vec_add_owned. 
+//
+// PARAMS: 
+// v - the vector to insert the element
+// d - the element to adopt
+// i - the index to insert to
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_owned(vec_t *v, void *d, size_t i);
+
+// Inserts count elements from a contiguous array into the specified vector. 
+// The tail is shifted once and every element will be copied. Nothing is 
+// inserted on error. 
+//
+// PARAMS: 
+// v     - the vector to insert the elements
+// i     - the index to insert to
+// src   - the array of elements
+// count - the number of elements
+// n     - the size of each element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_range(vec_t *v, size_t i, const void *src, size_t count, size_t n);
+
+// Deletes an element in the vector specified by the index. In tombstone mode 
+// the slot is only marked dead, see vec_set_tombstones. 
 //
 // PARAMS: 
 // v - the vector to delete the element
@@ -89,6 +507,26 @@ int vec_ins(vec_t *v, const void *d, size_t n, size_t i);
 // The deleted element, or NULL on error. 
 void *vec_del(vec_t *v, size_t i);
 
+// Removes an element in the vector specified by the index by moving the last 
+// element into its slot. Runs in constant time but does not keep the order. 
+//
+// PARAMS: 
+// v - the vector to remove the element
+// i - the index of the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *vec_swap_remove(vec_t *v, size_t i);
+
+// Removes the last element in the specified vector. 
+//
+// PARAMS: 
+// v - the vector to remove the element
+//
+// RET: 
+// The removed element, or NULL on error. 
+void *vec_pop(vec_t *v);
+
 // Deletes a range of elements in the specified vector. 
 //
 // PARAMS: 
@@ -97,12 +535,84 @@ void *vec_del(vec_t *v, size_t i);
 // n - the number of elements to delete
 void vec_delrange(vec_t *v, size_t i, size_t n);
 
+// Keeps only the elements accepted by the predicate, freeing the others. The 
+// order of the kept elements is preserved and the vector is walked once. 
+//
+// PARAMS: 
+// v    - the vector to filter
+// keep - the predicate, receives an element and the context
+// ctx  - the context passed to the predicate
+//
+// RET: 
+// The number of elements removed. 
+size_t vec_retain(vec_t *v, bool (*keep)(const void *, void *), void *ctx);
+
+// Calls the function on every element of the vector, in order. Dead slots 
+// are skipped, and the element VEC_PREFETCH_DIST slots ahead is prefetched 
+// before each call. 
+//
+// PARAMS: 
+// v   - the vector to walk
+// fn  - the function, receives an element and the context
+// ctx - the context passed to the function
+void vec_foreach(const vec_t *v, void (*fn)(void *, void *), void *ctx);
+
 // Reverts every element in the vector. 
 //
 // PARAMS: 
 // v - the vector to reverse. 
 void vec_reverse(vec_t *v);
 
+// Rotates the vector in place so the element at index k becomes the first, 
+// the elements before it moving to the end. Uses three reversals and no 
+// extra memory. Dead slots move with the others. 
+//
+// PARAMS: 
+// v - the vector to rotate
+// k - the index of the new first element, at most the length
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_rotate(vec_t *v, size_t k);
+
+// Swaps the n elements starting at index i with the n elements starting at 
+// index j, in place. The two ranges must not overlap. 
+//
+// PARAMS: 
+// v - the vector to modify
+// i - the start of the first range
+// j - the start of the second range
+// n - the number of elements in each range
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap_ranges(vec_t *v, size_t i, size_t j, size_t n);
+
+// Moves the contents of src into dst in constant time, leaving src empty as 
+// after vec_free. dst is overwritten without being freed, so it must be 
+// uninitialised or freed. A vector on a buffer it does not own has its slots 
+// copied to the heap first. 
+//
+// PARAMS: 
+// dst - the vector to move into
+// src - the vector to move from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_take(vec_t *dst, vec_t *src);
+
+// Swaps the contents of two vectors in constant time. A vector on a buffer 
+// it does not own has its slots copied to the heap first, so neither ends 
+// up on storage that belongs to the other. 
+//
+// PARAMS: 
+// a - the first vector
+// b - the second vector
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap(vec_t *a, vec_t *b);
+
 // Clears the specified vector, freeing all elements. 
 //
 // PARAMS: 
@@ -115,5 +625,296 @@ void vec_clear(vec_t *v);
 // v - the vector to free
 void vec_free(vec_t *v);
 
+// Gets the instrumentation counters of the specified vector, or the global 
+// counters summed over every vector if v is NULL. The counters are only 
+// recorded when the library is built with VEC_STATS defined, they read as 
+// zero otherwise. 
+//
+// PARAMS: 
+// v   - the vector, NULL for the global counters
+// out - where to store the counters
+void vec_stats_get(const vec_t *v, vec_stats_t *out);
+
+// Resets the instrumentation counters of the specified vector, or the global 
+// counters if v is NULL. The peak capacity of a vector restarts from its 
+// current capacity, the global peak restarts from zero and rises again as 
+// vectors grow. 
+//
+// PARAMS: 
+// v - the vector, NULL for the global counters
+void vec_stats_reset(vec_t *v);
+
+// Initialises the specified by-value vector. Every element will take n bytes 
+// in a single contiguous buffer. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each element
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized(vec_sized_t *v, size_t n);
+
+// Initialises the specified by-value vector with an allocator. 
+//
+// PARAMS: 
+// v - the vector to initialise
+// n - the size of each element
+// a - the allocator, NULL for malloc, realloc and free
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized_alloc(vec_sized_t *v, size_t n, const vec_alloc_t *a);
+
+// Initialises the specified by-value vector with room for exactly cap 
+// elements. 
+//
+// PARAMS: 
+// v   - the vector to initialise
+// n   - the size of each element
+// cap - number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized_cap(vec_sized_t *v, size_t n, size_t cap);
+
+// Initialises the specified by-value vector on top of a buffer of cap 
+// elements that is not owned by the vector. No allocation is made until the 
+// vector outgrows the buffer, its elements are then copied to the heap. The 
+// buffer is never resized or freed and must outlive the vector. 
+//
+// PARAMS: 
+// v   - the vector to initialise
+// n   - the size of each element
+// buf - the buffer, at least n * cap bytes
+// cap - the number of elements in the buffer
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_init_sized_buf(vec_sized_t *v, size_t n, void *buf, size_t cap);
+
+// Reserves n elements in the specified by-value vector. The buffer is 
+// resized to exactly n elements, nothing is done if it can already hold n 
+// elements. 
+//
+// PARAMS: 
+// v - the vector to reserve
+// n - number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_reserve_sized(vec_sized_t *v, size_t n);
+
+// Shrinks the buffer of the specified by-value vector to its current length. 
+// A vector still on a buffer it does not own is left as is. 
+//
+// PARAMS: 
+// v - the vector to shrink
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_shrink_to_fit_sized(vec_sized_t *v);
+
+// Sets the growth policy of the specified by-value vector. 
+//
+// PARAMS: 
+// v    - the vector to set
+// grow - VEC_GROW_DOUBLE, VEC_GROW_HALF or VEC_GROW_STEP
+// step - number of elements to grow by for VEC_GROW_STEP
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_set_growth_sized(vec_sized_t *v, int grow, size_t step);
+
+// Sorts the specified by-value vector using the comparison function. The 
+// comparison function receives pointers to the elements themselves. 
+//
+// PARAMS: 
+// v   - the vector to sort
+// cmp - the comparison function
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_sort_sized(vec_sized_t *v, int (*cmp)(const void *, const void *));
+
+// Adds a new element into the specified by-value vector. The new element will 
+// be copied into the buffer. 
+//
+// PARAMS: 
+// v - the vector to add the element
+// d - the element to add
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_sized(vec_sized_t *v, const void *d);
+
+// Adds count elements from a contiguous array into the specified by-value 
+// vector with a single copy. 
+//
+// PARAMS: 
+// v     - the vector to add the elements
+// src   - the array of elements
+// count - the number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_add_many_sized(vec_sized_t *v, const void *src, size_t count);
+
+// Appends every element in src to dst with a single copy. Both vectors must 
+// have the same element size. 
+//
+// PARAMS: 
+// dst - the vector to append to
+// src - the vector to copy from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_extend_sized(vec_sized_t *dst, const vec_sized_t *src);
+
+// Inserts a new element into the specified by-value vector. The new element 
+// will be copied into the buffer. 
+//
+// PARAMS: 
+// v - the vector to insert the element
+// d - the element to insert
+// i - the index to insert to
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_sized(vec_sized_t *v, const void *d, size_t i);
+
+// Inserts count elements from a contiguous array into the specified by-value 
+// vector. The tail is shifted once and the elements are copied in one block. 
+//
+// PARAMS: 
+// v     - the vector to insert the elements
+// i     - the index to insert to
+// src   - the array of elements
+// count - the number of elements
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_ins_range_sized(vec_sized_t *v, size_t i, const void *src, 
+        size_t count);
+
+// Returns the element in the by-value vector specified by the index. The 
+// returned pointer is invalidated by any call that grows the vector. 
+//
+// PARAMS: 
+// v - the vector to get the element
+// i - the index of the element
+//
+// RET: 
+// The element inside the buffer, or NULL on error. 
+void *vec_get_sized(const vec_sized_t *v, size_t i);
+
+// Deletes an element in the by-value vector specified by the index. 
+//
+// PARAMS: 
+// v   - the vector to delete the element
+// i   - the index of the element
+// out - where to copy the deleted element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_del_sized(vec_sized_t *v, size_t i, void *out);
+
+// Removes an element in the by-value vector specified by the index by moving 
+// the last element into its slot. Runs in constant time but does not keep 
+// the order. 
+//
+// PARAMS: 
+// v   - the vector to remove the element
+// i   - the index of the element
+// out - where to copy the removed element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap_remove_sized(vec_sized_t *v, size_t i, void *out);
+
+// Removes the last element in the specified by-value vector. 
+//
+// PARAMS: 
+// v   - the vector to remove the element
+// out - where to copy the removed element, can be NULL
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_pop_sized(vec_sized_t *v, void *out);
+
+// Deletes a range of elements in the specified by-value vector. 
+//
+// PARAMS: 
+// v - the vector to delete the elements
+// i - the starting index to delete
+// n - the number of elements to delete
+void vec_delrange_sized(vec_sized_t *v, size_t i, size_t n);
+
+// Keeps only the elements accepted by the predicate. The order of the kept 
+// elements is preserved and the vector is walked once. 
+//
+// PARAMS: 
+// v    - the vector to filter
+// keep - the predicate, receives an element and the context
+// ctx  - the context passed to the predicate
+//
+// RET: 
+// The number of elements removed. 
+size_t vec_retain_sized(vec_sized_t *v, bool (*keep)(const void *, void *), 
+        void *ctx);
+
+// Moves the contents of src into dst in constant time, leaving src empty as 
+// after vec_free_sized. dst is overwritten without being freed, so it must 
+// be uninitialised or freed. A vector on a buffer it does not own has its 
+// elements copied to the heap first. 
+//
+// PARAMS: 
+// dst - the by-value vector to move into
+// src - the by-value vector to move from
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_take_sized(vec_sized_t *dst, vec_sized_t *src);
+
+// Swaps the contents of two by-value vectors in constant time. A vector on a 
+// buffer it does not own has its elements copied to the heap first. 
+//
+// PARAMS: 
+// a - the first by-value vector
+// b - the second by-value vector
+//
+// RET: 
+// Zero on success, non-zero on error. 
+int vec_swap_sized(vec_sized_t *a, vec_sized_t *b);
+
+// Clears the specified by-value vector. 
+//
+// PARAMS: 
+// v - the vector to clear
+void vec_clear_sized(vec_sized_t *v);
+
+// Frees the internal buffer in the specified by-value vector. 
+//
+// PARAMS: 
+// v - the vector to free
+void vec_free_sized(vec_sized_t *v);
+
+// Gets the instrumentation counters of the specified by-value vector, or the 
+// global counters if v is NULL, see vec_stats_get. 
+//
+// PARAMS: 
+// v   - the by-value vector, NULL for the global counters
+// out - where to store the counters
+void vec_stats_get_sized(const vec_sized_t *v, vec_stats_t *out);
+
+// Resets the instrumentation counters of the specified by-value vector, or 
+// the global counters if v is NULL. The peak capacity of a vector restarts 
+// from its current capacity, the global peak restarts from zero and rises 
+// again as vectors grow. 
+//
+// PARAMS: 
+// v - the by-value vector, NULL for the global counters
+void vec_stats_reset_sized(vec_sized_t *v);
+
 #endif
 